@@ -0,0 +1,387 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bench.c
+ * @brief Benchmarks of the library.
+ * @details Run with make bench, or make bench BENCH="memory ..." for some of
+ * the modes only.
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include "num.h"
+#include "new.h"
+#include "num_private.h"
+#include "numr.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <flint/fmpz.h>
+#include <acb.h>
+
+#define NVALUES 100000
+
+/* Returns a monotonic time, in seconds */
+static double
+now (void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+/**********************************/
+/* Memory footprint of the values */
+/**********************************/
+
+static void
+report_value (const char * what, const num_t x)
+{
+    printf("  %-28s %6zu bytes\n", what, num_memory_usage(x));
+}
+
+static void
+bench_memory (void)
+{
+    num_t x, * v;
+    fmpz_t big;
+    size_t i, objects = 0;
+    long live;
+
+    printf("memory: footprint of one value\n");
+    x = new(num);
+    num_set_si(x, 42);
+    report_value("small integer", x);
+    num_set_d_d(x, 0.1, -2.5);
+    report_value("complex double", x);
+    num_set_d(x, 30.5);
+    num_gamma(x, x);
+    report_value("gamma(30.5)", x);
+    fmpz_init(big);
+    fmpz_set_ui(big, 10);
+    fmpz_pow_ui(big, big, 40);
+    num_set_fmpz(x, big);
+    report_value("exact 10^40", x);
+    fmpz_clear(big);
+    delete(x);
+    x = new(numr);
+    numr_set_d(x, 0.1);
+    printf("  %-28s %6zu bytes\n", "real double (numr)", numr_memory_usage(x));
+    delete(x);
+
+    printf("memory: %d values of exp(i k)\n", NVALUES);
+    v = malloc(NVALUES * sizeof(num_t));
+    num_thread_memory_reset();
+    live = num_thread_memory();
+    for (i = 0; i < NVALUES; i++)
+    {
+        v[i] = new(num);
+        num_set_d_d(v[i], 0.0, (double) i);
+        num_exp(v[i], v[i]);
+        objects += num_memory_usage(v[i]);
+    }
+    printf("  %-28s %10zu bytes\n", "num_memory_usage, total", objects);
+    printf("  %-28s %10ld bytes\n", "FLINT, live", num_thread_memory() - live);
+    printf("  %-28s %10ld bytes\n", "FLINT, peak", num_thread_memory_peak() - live);
+    printf("  %-28s %10ld\n", "FLINT, allocations", num_thread_allocations());
+    for (i = 0; i < NVALUES; i++)
+        delete(v[i]);
+    free(v);
+}
+
+/***********************************/
+/* Creation of many values at once */
+/***********************************/
+
+static void
+bench_alloc (void)
+{
+    num_t * v;
+    double t;
+    size_t i;
+
+    printf("alloc: %d values\n", NVALUES);
+    v = malloc(NVALUES * sizeof(num_t));
+    t = now();
+    for (i = 0; i < NVALUES; i++)
+        v[i] = new(num);
+    for (i = 0; i < NVALUES; i++)
+        delete(v[i]);
+    printf("  %-28s %8.2f ns/value\n", "new and delete", 1e9 * (now() - t) / NVALUES);
+    free(v);
+
+    t = now();
+    v = num_new_array(NVALUES);
+    num_delete_array(v, NVALUES);
+    printf("  %-28s %8.2f ns/value\n", "num_new_array", 1e9 * (now() - t) / NVALUES);
+}
+
+/****************************/
+/* Conversion from the text */
+/****************************/
+
+static void
+bench_parse (void)
+{
+    const size_t width = 24;
+    char * text = malloc(NVALUES * width + 1), * p = text, * q;
+    num_t * v = num_new_array(NVALUES);
+    size_t i, len, n;
+    double t;
+
+    for (i = 0; i < NVALUES; i++)
+        p += sprintf(p, "%.17g%c", (i + 0.5) / 7.0 - 1000.0, (i % 8 == 7) ? '\n' : ',');
+    len = p - text;
+
+    printf("parse: %d decimals, %zu bytes\n", NVALUES, len);
+    t = now();
+    n = num_set_str_vec(v, NVALUES, text, len);
+    t = now() - t;
+    printf("  %-28s %8.2f MB/s (%zu values)\n", "num_set_str_vec", 1e-6 * len / t, n);
+
+    t = now();
+    for (p = text, i = 0; i < NVALUES; i++, p = q + 1)
+        num_set_d(v[i], strtod(p, &q));
+    t = now() - t;
+    printf("  %-28s %8.2f MB/s\n", "strtod and num_set_d", 1e-6 * len / t);
+
+    num_delete_array(v, NVALUES);
+    free(text);
+}
+
+/*********************************************/
+/* Latency of the first calls in each thread */
+/*********************************************/
+
+#define NCALLS 1000
+/* Bucket b counts the calls of [2^b, 2^(b+1)) nanoseconds */
+#define NBUCKETS 32
+
+struct latency
+{
+    const char * name;
+    void (* f) (num_t, const num_t);
+    bool warm;
+    double first;
+    size_t hist[NBUCKETS];
+};
+
+static void
+latency_arg (num_t x, const size_t k)
+{
+    num_set_d_d(x, 0.5 + (double) (k * 37 % 61), 0.25 * (double) (k % 3));
+}
+
+static void
+latency_record (struct latency * l, const double seconds)
+{
+    int b = 0;
+
+    while (b < NBUCKETS - 1 && seconds * 1e9 >= (double) (2UL << b)) b++;
+    l -> hist[b]++;
+}
+
+/* Upper bound, in ns, of the bucket holding the q-quantile of the calls */
+static unsigned long
+latency_quantile (const struct latency * l, const double q)
+{
+    size_t seen = 0;
+    int b;
+
+    for (b = 0; b < NBUCKETS; b++)
+    {
+        seen += l -> hist[b];
+        if (seen >= q * NCALLS) break;
+    }
+    return 2UL << b;
+}
+
+/* Runs in a new thread, whose caches are empty */
+static void *
+latency_run (void * arg)
+{
+    struct latency * l = arg;
+    num_t x, y;
+    double t;
+    size_t k;
+
+    num_thread_init();
+    if (l -> warm) num_warmup(l -> name, 53);
+    x = new(num), y = new(num);
+
+    latency_arg(x, 0);
+    t = now();
+    l -> f(y, x);
+    l -> first = now() - t;
+    for (k = 0; k < NCALLS; k++)
+    {
+        latency_arg(x, k);
+        t = now();
+        l -> f(y, x);
+        latency_record(l, now() - t);
+    }
+
+    delete(x), delete(y);
+    num_thread_cleanup();
+    return NULL;
+}
+
+static void
+bench_latency (void)
+{
+    static const struct latency functions[] =
+    {
+        {"exp", num_exp, false, 0.0, {0}},
+        {"log", num_log, false, 0.0, {0}},
+        {"erf", num_erf, false, 0.0, {0}},
+        {"gamma", num_gamma, false, 0.0, {0}},
+        {"rgamma", num_rgamma, false, 0.0, {0}},
+        {"digamma", num_digamma, false, 0.0, {0}}
+    };
+    struct latency cold, warm;
+    pthread_t thread;
+    size_t k;
+    int b;
+
+    printf("latency: first call in a new thread, then %d calls\n", NCALLS);
+    for (k = 0; k < sizeof(functions) / sizeof(functions[0]); k++)
+    {
+        cold = functions[k], warm = functions[k];
+        warm.warm = true;
+        pthread_create(&thread, NULL, latency_run, &cold);
+        pthread_join(thread, NULL);
+        pthread_create(&thread, NULL, latency_run, &warm);
+        pthread_join(thread, NULL);
+
+        printf("  %-8s first %9.2f us, after num_warmup %9.2f us, "
+               "p50 < %lu ns, p99 < %lu ns\n", cold.name, 1e6 * cold.first,
+               1e6 * warm.first, latency_quantile(&cold, 0.5), latency_quantile(&cold, 0.99));
+        printf("          ");
+        for (b = 0; b < NBUCKETS; b++)
+            if (cold.hist[b] > 0) printf(" [%lu ns: %zu]", 1UL << b, cold.hist[b]);
+        printf("\n");
+    }
+}
+
+/******************************************/
+/* Real and half-integer argument classes */
+/******************************************/
+
+#define NPOW 10000
+
+static void
+bench_pow (void)
+{
+    static const double exponents[] = {2.0, 3.0, -1.0, 0.5, 1.5, 2.37};
+    static const char * const names[] = {"num_pow", "num_sqrt", "num_exp", "num_log"};
+    const size_t nexp = sizeof(exponents) / sizeof(exponents[0]);
+    num_t * x = num_new_array(NPOW), * y = num_new_array(NPOW), res = new(num);
+    struct num * _res = res;
+    double t_fast[4], t_generic[4], t;
+    size_t i;
+    int k;
+
+    for (i = 0; i < NPOW; i++)
+    {
+        /* One complex base in eight */
+        num_set_d_d(x[i], 0.5 + 0.37 * (double) (i % 97), (i % 8 == 7) ? 0.25 : 0.0);
+        num_set_d(y[i], exponents[i % nexp]);
+    }
+
+    printf("pow: %d mixed arguments, one in eight complex\n", NPOW);
+    for (k = 0; k < 4; k++)
+    {
+        t = now();
+        for (i = 0; i < NPOW; i++)
+            switch (k)
+            {
+            case 0: num_pow(res, x[i], y[i]); break;
+            case 1: num_sqrt(res, x[i]); break;
+            case 2: num_exp(res, x[i]); break;
+            default: num_log(res, x[i]); break;
+            }
+        t_fast[k] = now() - t;
+
+        t = now();
+        for (i = 0; i < NPOW; i++)
+        {
+            const struct num * _x = x[i], * _y = y[i];
+            switch (k)
+            {
+            case 0: acb_pow(_res -> dat, _x -> dat, _y -> dat, 53); break;
+            case 1: acb_sqrt(_res -> dat, _x -> dat, 53); break;
+            case 2: acb_exp(_res -> dat, _x -> dat, 53); break;
+            default: acb_log(_res -> dat, _x -> dat, 53); break;
+            }
+        }
+        t_generic[k] = now() - t;
+    }
+
+    for (k = 0; k < 4; k++)
+        printf("  %-8s %8.1f ns/call, generic acb %8.1f ns/call, speedup %5.2fx\n",
+               names[k],
+               1e9 * t_fast[k] / NPOW, 1e9 * t_generic[k] / NPOW, t_generic[k] / t_fast[k]);
+
+    delete(res);
+    num_delete_array(x, NPOW), num_delete_array(y, NPOW);
+}
+
+/**********/
+/* Driver */
+/**********/
+
+struct bench
+{
+    const char * name;
+    void (* run) (void);
+};
+
+static const struct bench benches[] =
+{
+    {"memory", bench_memory},
+    {"alloc", bench_alloc},
+    {"parse", bench_parse},
+    {"latency", bench_latency},
+    {"pow", bench_pow}
+};
+#define NBENCHES (sizeof(benches) / sizeof(benches[0]))
+
+/* Runs the benchmarks named on the command line, or all of them */
+int
+main (int argc, char ** argv)
+{
+    size_t k;
+    int i;
+
+    num_thread_init();
+    for (k = 0; k < NBENCHES; k++)
+    {
+        bool run = (argc < 2);
+
+        for (i = 1; i < argc; i++)
+            if (strcmp(argv[i], benches[k].name) == 0) run = true;
+        if (run) benches[k].run();
+    }
+    num_thread_cleanup();
+
+    return 0;
+}
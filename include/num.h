@@ -26,6 +26,10 @@
 #include <stdbool.h>
 #include <complex.h>
 #include <stdarg.h>
+#include <stddef.h>
+
+#include <flint/fmpz.h>
+#include <flint/fmpq.h>
 
 /**
  * This should be used in the initialization of the variable
@@ -40,9 +44,54 @@ extern const void * num;
  */
 typedef void * num_t;
 
+/**
+ * Creates \p n values, set to zero, in a single allocation, and returns an
+ * array of them. The values are used as those created by new(num), but must
+ * be released all at once with num_delete_array() instead of delete().
+ * Returns NULL if the allocation fails.
+ */
+num_t *
+num_new_array (const size_t n);
+
+/**
+ * Releases the \p n values created by num_new_array().
+ */
+void
+num_delete_array (num_t * arr, const size_t n);
+
+/**
+ * Signature of the user functions of one variable taken by the solvers and
+ * integrators. \p ctx is passed through untouched.
+ */
+typedef void (* num_func_t) (num_t res, const num_t x, void * ctx);
+
 void
 num_print (const num_t self, const bool endline);
 
+/**
+ * Sets \p self to the number written in \p str and returns true, or returns
+ * false and leaves \p self alone if \p str is not a number.
+ *
+ * The syntax is that of decimal literals ("-31.4159e-1", "inf", "nan"),
+ * balls ("[3.25 +/- 0.0001]", "3.25 +/- 0.0001") and complex numbers
+ * ("1.5-2i", "[1 +/- 0.1]+2i", "-i"), blanks around being ignored. A
+ * decimal is rounded to nearest at the working precision, and the radius
+ * covers the rounding error, so that the ball contains the decimal.
+ */
+bool
+num_set_str (num_t self, const char* str);
+
+/**
+ * Parses the \p len characters of \p text, numbers in the syntax of
+ * num_set_str() separated by commas or newlines, into \p res, and returns
+ * the number of values set.
+ *
+ * Empty fields are skipped. Parsing stops after \p n values, at the end of
+ * \p text, or before the first field which is not a number.
+ */
+size_t
+num_set_str_vec (num_t* res, const size_t n, const char* text, const size_t len);
+
 /**
  * Sets \p self to zero.
  */
@@ -70,6 +119,26 @@ num_set_d (num_t self, const double x);
 void
 num_set_d_d (num_t self, const double x, const double y);
 
+/**
+ * Sets \p self to the integer \p x, exactly.
+ */
+void
+num_set_si (num_t self, const long x);
+void
+num_set_ui (num_t self, const unsigned long x);
+
+/**
+ * Sets \p self to the FLINT integer \p x, exactly.
+ */
+void
+num_set_fmpz (num_t self, const fmpz_t x);
+
+/**
+ * Sets \p self to the FLINT rational \p x, rounded to the working precision.
+ */
+void
+num_set_q (num_t self, const fmpq_t x);
+
 /***************************************/
 /* Accessors: Real and Imaginary parts */
 /***************************************/
@@ -106,6 +175,107 @@ num_is_zero (const num_t self);
 bool
 num_is_real (const num_t self);
 
+/**
+ * Returns true iff \p self and \p other are the same ball, with bitwise
+ * equal midpoints and radii.
+ */
+bool
+num_is_identical (const num_t self, const num_t other);
+
+/**************************/
+/* Ball radius and modes */
+/**************************/
+
+/**
+ * Arithmetic modes, selected per thread with num_set_mode().
+ */
+enum num_mode
+{
+    /** Rigorous ball arithmetic (the default) */
+    NUM_MODE_BALL = 0,
+    /**
+     * num_add(), num_sub(), num_mul() and num_div() (and the _d forms built
+     * on them) work on the midpoints only and return exact points. The other
+     * functions still return balls, whose radius is dropped by the next
+     * arithmetic operation.
+     */
+    NUM_MODE_MID
+};
+
+/**
+ * Sets the arithmetic mode of the calling thread.
+ */
+void
+num_set_mode (const int mode);
+
+/**
+ * Returns the arithmetic mode of the calling thread.
+ */
+int
+num_get_mode (void);
+
+/**
+ * Returns an upper bound for the radius of \p self: the largest of the radii
+ * of its real and imaginary parts.
+ */
+double
+num_rad_d (const num_t self);
+
+/**
+ * Returns the relative accuracy of \p self in bits, as given by
+ * acb_rel_accuracy_bits().
+ */
+long
+num_rel_accuracy_bits (const num_t self);
+
+/**
+ * Sets \p res to the midpoint of \p self, with zero radius.
+ */
+void
+num_mid (num_t res, const num_t self);
+
+/**************/
+/* Exceptions */
+/**************/
+
+/**
+ * Exception flags, raised by the functions instead of aborting, and sticky
+ * like those of IEEE 754: a flag stays raised in the calling thread until
+ * num_clear_flags() lowers it. The flags raised in the worker threads of
+ * the vector functions are not seen by the caller.
+ */
+enum num_flag
+{
+    /**
+     * A function defined on reals only (num_to_d(), num_lt(), num_ceil(),
+     * num_fmod(), num_max(), ...) got a non-real argument, whose imaginary
+     * part was ignored.
+     */
+    NUM_FLAG_NONREAL = 1,
+    /** num_div(), num_inv() or one of their forms divided by an exact zero */
+    NUM_FLAG_DIVBYZERO = 2,
+    /**
+     * A conversion to double (num_to_d(), num_real_d(), ...) returned a
+     * ball accurate to fewer than 26 bits, half those of a double.
+     */
+    NUM_FLAG_PRECISION = 4,
+    /** A conversion to double returned NaN */
+    NUM_FLAG_NAN = 8
+};
+
+/**
+ * Returns the flags among \p flags (a bitwise or of ::num_flag values)
+ * raised in the calling thread.
+ */
+int
+num_test_flags (const int flags);
+
+/**
+ * Lowers the flags \p flags in the calling thread.
+ */
+void
+num_clear_flags (const int flags);
+
 /****************/
 /* Type casting */
 /****************/
@@ -198,6 +368,100 @@ num_cos (num_t res, const num_t self);
 void
 num_cosh (num_t res, const num_t self);
 
+/**
+ * Returns the tangent of the number
+ */
+void
+num_tan (num_t res, const num_t self);
+
+/**
+ * Returns the inverse tangent of the number
+ */
+void
+num_atan (num_t res, const num_t self);
+
+/**
+ * Returns the inverse sine of the number
+ */
+void
+num_asin (num_t res, const num_t self);
+
+/**
+ * Returns the inverse cosine of the number
+ */
+void
+num_acos (num_t res, const num_t self);
+
+/**
+ * Returns the angle of the point (\p x, \p y) in the plane,
+ * \f$\mathrm{atan2}(y, x)\f$. Both arguments must be real.
+ */
+void
+num_atan2 (num_t res, const num_t y, const num_t x);
+
+/**
+ * Returns \f$\log(1 + x)\f$, accurate for small \f$x\f$.
+ */
+void
+num_log1p (num_t res, const num_t self);
+
+/**
+ * Returns \f$e^x - 1\f$, accurate for small \f$x\f$.
+ */
+void
+num_expm1 (num_t res, const num_t self);
+
+/**
+ * Returns the cube root of the number. For real numbers this is the real
+ * cube root, otherwise the principal one.
+ */
+void
+num_cbrt (num_t res, const num_t self);
+
+/**
+ * Returns the reciprocal square root of the number, \f$1/\sqrt{x}\f$.
+ */
+void
+num_rsqrt (num_t res, const num_t self);
+
+/**
+ * Sets \p s and \p c to the sine and cosine of the number, computed
+ * together.
+ */
+void
+num_sin_cos (num_t s, num_t c, const num_t self);
+
+/**
+ * Sets \p s and \p c to the hyperbolic sine and cosine of the number,
+ * computed together.
+ */
+void
+num_sinh_cosh (num_t s, num_t c, const num_t self);
+
+/**
+ * Returns \f$e^{\pi i x}\f$.
+ */
+void
+num_exp_pi_i (num_t res, const num_t self);
+
+/**
+ * Sets \p s and \p c to \f$\sin(\pi x)\f$ and \f$\cos(\pi x)\f$,
+ * computed together.
+ */
+void
+num_sin_cos_pi (num_t s, num_t c, const num_t self);
+
+/**
+ * Vector forms of the functions above, evaluated at the \p n points of \p
+ * x.
+ */
+void
+num_sin_cos_vec (num_t* s, num_t* c, const num_t* x, const size_t n);
+void
+num_sinh_cosh_vec (num_t* s, num_t* c, const num_t* x, const size_t n);
+void
+num_sin_cos_pi_vec (num_t* s, num_t* c, const num_t* x, const size_t n);
+
 /*********************/
 /* Binary operations */
 /*********************/
@@ -213,12 +477,22 @@ void
 num_add (num_t res, const num_t self, const num_t other);
 void
 num_add_d (num_t res, const num_t self, const double other);
+void
+num_add_si (num_t res, const num_t self, const long other);
+void
+num_add_c (num_t res, const num_t self, const double complex other);
 
 /**
  * returns the subtraction of \p _self (\f$x\f$) and \p _other (\f$y\f$), \f$x - y\f$.
  */
 void
 num_sub (num_t res, const num_t self, const num_t other);
+void
+num_sub_d (num_t res, const num_t self, const double other);
+void
+num_sub_si (num_t res, const num_t self, const long other);
+void
+num_sub_c (num_t res, const num_t self, const double complex other);
 
 /**
  * returns the multiplication of \p _self (\f$x\f$) and \p _other (\f$y\f$), \f$x\cdot y\f$.
@@ -227,12 +501,42 @@ void
 num_mul (num_t res, const num_t self, const num_t other);
 void
 num_mul_d (num_t res, const num_t self, const double other);
+void
+num_mul_c (num_t res, const num_t self, const double complex other);
+void
+num_mul_si (num_t res, const num_t self, const long other);
+
+/**
+ * returns \p _self (\f$x\f$) times a power of two, \f$x \cdot 2^e\f$. This is
+ * exact.
+ */
+void
+num_mul_2exp (num_t res, const num_t self, const long e);
 
 /**
  * returns the division of \p _self (\f$x\f$) and \p _other (\f$y\f$), \f$x/y\f$.
  */
 void
 num_div (num_t res, const num_t self, const num_t other);
+void
+num_div_d (num_t res, const num_t self, const double other);
+void
+num_div_si (num_t res, const num_t self, const long other);
+void
+num_div_c (num_t res, const num_t self, const double complex other);
+void
+num_div_ui (num_t res, const num_t self, const unsigned long other);
+
+/**
+ * Sets \p res to \f$x/y\f$ for a scalar \p x, as num_div() does, so that
+ * the quotient of exact operands stays exact.
+ */
+void
+num_d_div (num_t res, const double x, const num_t y);
+void
+num_si_div (num_t res, const long x, const num_t y);
+void
+num_c_div (num_t res, const double complex x, const num_t y);
 
 /**
  *  Returns the remainder of the division of \p _self (\f$x\f$) and \p _other (\f$y\f$), \f$x/y\f$.
@@ -242,12 +546,23 @@ num_fmod (num_t res, const num_t self, const num_t other);
 
 /**
  * returns the exponentiation of \p _self (\f$x\f$) to \p _other (\f$y\f$), \f$x^y\f$.
+ *
+ * Integer and half-integer exponents are computed by repeated squaring,
+ * after a square root for the latter, and exactly for small integers. Real
+ * exponents of positive real bases stay on the real line.
  */
 void
 num_pow (num_t res, const num_t self, const num_t other);
 void
 num_pow_d (num_t res, const num_t self, const double other);
 
+/**
+ * returns \p _self (\f$x\f$) to the integer power \p other (\f$n\f$), \f$x^n\f$,
+ * by binary exponentiation.
+ */
+void
+num_pow_si (num_t res, const num_t self, const long other);
+
 /***********/
 /* Logical */
 /***********/
@@ -294,9 +609,274 @@ num_erfc (num_t res, const num_t self);
 void
 num_rgamma (num_t res, const num_t self);
 
+/**
+ * Returns the gamma function of \p self, \f$\Gamma(x)\f$.
+ */
+void
+num_gamma (num_t res, const num_t self);
+
+/**
+ * Returns the principal branch of the logarithm of the gamma function,
+ * \f$\log\Gamma(x)\f$.
+ */
+void
+num_lgamma (num_t res, const num_t self);
+
+/**
+ * Returns the digamma function \f$\psi(x) = \Gamma'(x)/\Gamma(x)\f$.
+ */
+void
+num_digamma (num_t res, const num_t self);
+
+/**
+ * Returns the Bessel function of the first kind, \f$J_\nu(z)\f$.
+ */
+void
+num_bessel_j (num_t res, const num_t nu, const num_t z);
+
+/**
+ * Returns the Bessel function of the second kind, \f$Y_\nu(z)\f$.
+ */
+void
+num_bessel_y (num_t res, const num_t nu, const num_t z);
+
+/**
+ * Returns the modified Bessel function of the first kind, \f$I_\nu(z)\f$.
+ */
+void
+num_bessel_i (num_t res, const num_t nu, const num_t z);
+
+/**
+ * Returns the modified Bessel function of the second kind, \f$K_\nu(z)\f$.
+ */
+void
+num_bessel_k (num_t res, const num_t nu, const num_t z);
+
+/**
+ * Returns the generalized exponential integral \f$E_s(z)\f$.
+ */
+void
+num_expint (num_t res, const num_t s, const num_t z);
+
+/**
+ * Returns the upper incomplete gamma function \f$\Gamma(s, z)\f$.
+ */
+void
+num_incgamma (num_t res, const num_t s, const num_t z);
+
+/**
+ * Returns the confluent hypergeometric function \f${}_1F_1(a; b; z)\f$.
+ */
+void
+num_hyp1f1 (num_t res, const num_t a, const num_t b, const num_t z);
+
+/**
+ * Returns the Gauss hypergeometric function \f${}_2F_1(a, b; c; z)\f$.
+ */
+void
+num_hyp2f1 (num_t res, const num_t a, const num_t b, const num_t c, const num_t z);
+
+/**********************************/
+/* Special functions: vector form */
+/**********************************/
+
+/**
+ * The functions below evaluate the function of the same name at the \p n
+ * points of \p x (or \p z), storing the results in \p res. The parameters
+ * are shared by all the points.
+ */
+void
+num_gamma_vec (num_t* res, const num_t* x, const size_t n);
+void
+num_lgamma_vec (num_t* res, const num_t* x, const size_t n);
+void
+num_digamma_vec (num_t* res, const num_t* x, const size_t n);
+void
+num_bessel_j_vec (num_t* res, const num_t nu, const num_t* z, const size_t n);
+void
+num_bessel_y_vec (num_t* res, const num_t nu, const num_t* z, const size_t n);
+void
+num_bessel_i_vec (num_t* res, const num_t nu, const num_t* z, const size_t n);
+void
+num_bessel_k_vec (num_t* res, const num_t nu, const num_t* z, const size_t n);
+void
+num_expint_vec (num_t* res, const num_t s, const num_t* z, const size_t n);
+void
+num_incgamma_vec (num_t* res, const num_t s, const num_t* z, const size_t n);
+void
+num_hyp1f1_vec (num_t* res, const num_t a, const num_t b, const num_t* z, const size_t n);
+void
+num_hyp2f1_vec (num_t* res, const num_t a, const num_t b, const num_t c, const num_t* z, const size_t n);
+
 void
 num_max (num_t res, const num_t self, const num_t other);
 
 void
 num_max3 (num_t res, const num_t self, const num_t other, const num_t another);
+
+/**
+ * Returns a ball containing both \p self and \p other.
+ */
+void
+num_union (num_t res, const num_t self, const num_t other);
+
+/*************/
+/* Constants */
+/*************/
+
+/*
+ * The constants are computed once for the whole process and shared by all
+ * the threads, so that only the first call in the process, or
+ * num_const_warmup(), pays for them.
+ */
+
+/**
+ * Sets \p res to \f$\pi\f$.
+ */
+void
+num_const_pi (num_t res);
+
+/**
+ * Sets \p res to \f$e\f$.
+ */
+void
+num_const_e (num_t res);
+
+/**
+ * Sets \p res to \f$\log 2\f$.
+ */
+void
+num_const_log2 (num_t res);
+
+/**
+ * Sets \p res to the Euler constant \f$\gamma\f$.
+ */
+void
+num_const_euler (num_t res);
+
+/**
+ * Sets \p res to the Catalan constant \f$G\f$.
+ */
+void
+num_const_catalan (num_t res);
+
+/**
+ * Computes all the constants at \p prec bits (at least the working
+ * precision), so that later calls do not. Meant to be called at startup.
+ */
+void
+num_const_warmup (const long prec);
+
+/**************/
+/* Reductions */
+/**************/
+
+/*
+ * The reductions are reproducible: the \p n terms are cut in blocks of fixed
+ * size, each block is summed by acb_dot() with a single rounding, and the
+ * partial sums are added along a fixed binary tree. The result is then
+ * bitwise the same for any number of threads, \p nthreads being only a hint
+ * on how many to use.
+ */
+
+/**
+ * Sets \p res to the sum of the \p n values \p x.
+ */
+void
+num_sum_vec (num_t res, const num_t* x, const size_t n, const int nthreads);
+
+/**
+ * Sets \p res to the sum of the \p n products \f$x_i y_i\f$.
+ */
+void
+num_dot_vec (num_t res, const num_t* x, const num_t* y, const size_t n, const int nthreads);
+
+/***********/
+/* Threads */
+/***********/
+
+/*
+ * Threading model: the functions of this header are reentrant. Distinct
+ * objects may be used concurrently from any number of threads, and one
+ * object may be read concurrently, but an object being written must not be
+ * accessed by any other thread at the same time; no locking is done here.
+ *
+ * Arb and FLINT keep per-thread caches (constants such as pi, Bernoulli
+ * numbers, logarithm tables) which grow on first use and are not released
+ * until the thread calls num_thread_cleanup().
+ */
+
+/**
+ * Prepares the calling thread for using the library.
+ *
+ * The first call also installs the memory functions of FLINT used by
+ * num_thread_memory(); it should happen before any other call in the
+ * process. Later calls, from any thread, are cheap.
+ */
+void
+num_thread_init (void);
+
+/**
+ * Releases the caches of Arb and FLINT held by the calling thread.
+ *
+ * Worker threads should call it before exiting. The library remains usable
+ * afterwards; the caches are simply rebuilt on demand.
+ */
+void
+num_thread_cleanup (void);
+
+/**
+ * Builds, in the calling thread, the caches used by the first calls to the
+ * special functions, so that these calls are not slower than the next
+ * ones, and fills the cache of the constants (see num_const_warmup()).
+ *
+ * \p functions is a comma-separated list of names among "exp", "log",
+ * "sin", "cos", "atan", "erf", "erfc", "gamma", "rgamma", "lgamma" and
+ * "digamma", or NULL for all of them; \p prec is the precision in bits,
+ * at least the working precision. Returns false if some name is unknown,
+ * after warming up the others.
+ *
+ * The caches being per thread, each worker should call it after
+ * num_thread_init().
+ */
+bool
+num_warmup (const char* functions, const long prec);
+
+/**
+ * Returns the number of bytes taken by \p self: the object itself, as given
+ * by size_of(), plus the limbs and exponents allocated by Arb for it.
+ */
+size_t
+num_memory_usage (const num_t self);
+
+/**
+ * Returns the number of bytes allocated through FLINT by the calling thread
+ * and not yet freed by it, since num_thread_init(). The counters need the
+ * size of the blocks from the C library, and stay at zero on the platforms
+ * other than glibc and macOS.
+ */
+long
+num_thread_memory (void);
+
+/**
+ * Returns the largest value reached by num_thread_memory() since
+ * num_thread_init() or the last num_thread_memory_reset().
+ */
+long
+num_thread_memory_peak (void);
+
+/**
+ * Returns the number of blocks allocated through FLINT by the calling
+ * thread since num_thread_init() or the last num_thread_memory_reset().
+ */
+long
+num_thread_allocations (void);
+
+/**
+ * Restarts the peak and allocation counters of the calling thread from its
+ * current memory usage.
+ */
+void
+num_thread_memory_reset (void);
+
 #endif /* __NUM_H__ */
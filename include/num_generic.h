@@ -0,0 +1,146 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file num_generic.h
+ * @brief Type-generic arithmetic on top of num.h.
+ * @details The macros pick, at compile time, the kernel matching the types
+ * of the operands, so that
+ * @code
+ * NUM_ADD(res, x, 2.5);
+ * NUM_MUL(res, 3, x);
+ * @endcode
+ * call num_add_d() and num_mul_si() without boxing the scalars. Each operand
+ * may be a ::num_t, a double (or float), a double complex, or an int or long;
+ * at least one of them must be a ::num_t.
+ *
+ * _Generic is a C11 feature; GCC and Clang also accept it in C99 mode.
+ */
+#ifndef __NUM_GENERIC_H__
+#define __NUM_GENERIC_H__
+
+#include <complex.h>
+
+#include "num.h"
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define NUM_GENERIC_EXTENSION_
+#elif defined(__GNUC__)
+#define NUM_GENERIC_EXTENSION_ __extension__
+#else
+#error "num_generic.h requires _Generic (C11)"
+#endif
+
+/*
+ * Kernels with the scalar as first operand
+ */
+
+static inline void
+num_d_add (num_t res, const double x, const num_t y)
+{
+    num_add_d(res, y, x);
+}
+
+static inline void
+num_si_add (num_t res, const long x, const num_t y)
+{
+    num_add_si(res, y, x);
+}
+
+static inline void
+num_c_add (num_t res, const double complex x, const num_t y)
+{
+    num_add_c(res, y, x);
+}
+
+static inline void
+num_d_sub (num_t res, const double x, const num_t y)
+{
+    num_sub_d(res, y, x);
+    num_neg(res, res);
+}
+
+static inline void
+num_si_sub (num_t res, const long x, const num_t y)
+{
+    num_sub_si(res, y, x);
+    num_neg(res, res);
+}
+
+static inline void
+num_c_sub (num_t res, const double complex x, const num_t y)
+{
+    num_sub_c(res, y, x);
+    num_neg(res, res);
+}
+
+static inline void
+num_d_mul (num_t res, const double x, const num_t y)
+{
+    num_mul_d(res, y, x);
+}
+
+static inline void
+num_si_mul (num_t res, const long x, const num_t y)
+{
+    num_mul_si(res, y, x);
+}
+
+static inline void
+num_c_mul (num_t res, const double complex x, const num_t y)
+{
+    num_mul_c(res, y, x);
+}
+
+/* num_d_div(), num_si_div() and num_c_div() are declared in num.h */
+
+/* Selects the kernel num_<op>, num_<op>_<t> or num_<t>_<op> */
+#define NUM_SELECT_(op, a, b) _Generic((a),                             \
+        num_t: _Generic((b),                                            \
+                        num_t: num_##op,                                \
+                        double: num_##op##_d,                           \
+                        float: num_##op##_d,                            \
+                        double complex: num_##op##_c,                   \
+                        long: num_##op##_si,                            \
+                        int: num_##op##_si),                            \
+        double: num_d_##op,                                             \
+        float: num_d_##op,                                              \
+        double complex: num_c_##op,                                     \
+        long: num_si_##op,                                              \
+        int: num_si_##op)
+
+/**
+ * Sets \p res to \f$a + b\f$.
+ */
+#define NUM_ADD(res, a, b) (NUM_GENERIC_EXTENSION_ NUM_SELECT_(add, a, b))(res, a, b)
+
+/**
+ * Sets \p res to \f$a - b\f$.
+ */
+#define NUM_SUB(res, a, b) (NUM_GENERIC_EXTENSION_ NUM_SELECT_(sub, a, b))(res, a, b)
+
+/**
+ * Sets \p res to \f$a \cdot b\f$.
+ */
+#define NUM_MUL(res, a, b) (NUM_GENERIC_EXTENSION_ NUM_SELECT_(mul, a, b))(res, a, b)
+
+/**
+ * Sets \p res to \f$a / b\f$.
+ */
+#define NUM_DIV(res, a, b) (NUM_GENERIC_EXTENSION_ NUM_SELECT_(div, a, b))(res, a, b)
+
+#endif /* __NUM_GENERIC_H__ */
@@ -0,0 +1,176 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file num_inline.h
+ * @brief Inline versions of the cheap operations of num.h.
+ * @details This optional header exposes the representation of the class, so
+ * that the functions below can be inlined in the caller; it requires the
+ * Arb headers. Each function behaves as the one of num.h without the \c
+ * _inline suffix, including the arithmetic mode of num_set_mode().
+ */
+#ifndef __NUM_INLINE_H__
+#define __NUM_INLINE_H__
+
+#include <stdbool.h>
+
+#include "num.h"
+
+#include <acb.h>
+
+/* Working precision, in bits */
+#define NUM_PREC 53
+
+/* Relative accuracy, in bits, below which a conversion raises NUM_FLAG_PRECISION */
+#define NUM_PRECISION_MIN_BITS 26
+
+/* Representations of struct num */
+enum num_tag
+{
+    /* Only dat is meaningful */
+    NUM_TAG_ACB = 0,
+    /* dat holds exactly the machine integer si */
+    NUM_TAG_SI
+};
+
+/*
+ * dat is always up to date, so any function may read it. The tag only
+ * records that the value is also available as a machine integer, which lets
+ * arithmetic and comparisons on small integers skip Arb: a function writing
+ * dat without maintaining the tag must clear it with num_writable_(). si
+ * never holds WORD_MIN, so negating it cannot overflow.
+ */
+struct num
+{
+    const void * class; /* must be first */
+    acb_t dat;
+    int tag;
+    slong si;
+};
+
+/* Arithmetic mode of the calling thread, see num_set_mode() */
+extern FLINT_TLS_PREFIX int num_thread_mode;
+
+/* Clears the small-integer tag of self, which is about to be written */
+static inline struct num *
+num_writable_ (num_t self)
+{
+    struct num * _self = self;
+    _self -> tag = NUM_TAG_ACB;
+    return _self;
+}
+
+static inline void
+num_set_inline (num_t self, const num_t other)
+{
+    struct num * _self = self;
+    const struct num * _other = other;
+    acb_set(_self -> dat, _other -> dat);
+    _self -> tag = _other -> tag, _self -> si = _other -> si;
+}
+
+static inline void
+num_neg_inline (num_t res, const num_t self)
+{
+    struct num * _res = res;
+    const struct num * _self = self;
+    acb_neg(_res -> dat, _self -> dat);
+    _res -> tag = _self -> tag, _res -> si = -_self -> si;
+}
+
+static inline void
+num_conj_inline (num_t res, const num_t self)
+{
+    struct num * _res = res;
+    const struct num * _self = self;
+    acb_conj(_res -> dat, _self -> dat);
+    _res -> tag = _self -> tag, _res -> si = _self -> si;
+}
+
+static inline void
+num_add_inline (num_t res, const num_t self, const num_t other)
+{
+    struct num * _res = res;
+    const struct num * _self = self;
+    const struct num * _other = other;
+
+    /* Small integers take the exact path of num_add() */
+    if (num_thread_mode == NUM_MODE_BALL && (_self -> tag | _other -> tag) == NUM_TAG_ACB)
+    {
+        acb_add(_res -> dat, _self -> dat, _other -> dat, NUM_PREC);
+        _res -> tag = NUM_TAG_ACB;
+    }
+    else
+        num_add(res, self, other);
+}
+
+static inline void
+num_sub_inline (num_t res, const num_t self, const num_t other)
+{
+    struct num * _res = res;
+    const struct num * _self = self;
+    const struct num * _other = other;
+
+    /* Small integers take the exact path of num_sub() */
+    if (num_thread_mode == NUM_MODE_BALL && (_self -> tag | _other -> tag) == NUM_TAG_ACB)
+    {
+        acb_sub(_res -> dat, _self -> dat, _other -> dat, NUM_PREC);
+        _res -> tag = NUM_TAG_ACB;
+    }
+    else
+        num_sub(res, self, other);
+}
+
+static inline void
+num_mul_inline (num_t res, const num_t self, const num_t other)
+{
+    struct num * _res = res;
+    const struct num * _self = self;
+    const struct num * _other = other;
+
+    /* Small integers take the exact path of num_mul() */
+    if (num_thread_mode == NUM_MODE_BALL && (_self -> tag | _other -> tag) == NUM_TAG_ACB)
+    {
+        acb_mul(_res -> dat, _self -> dat, _other -> dat, NUM_PREC);
+        _res -> tag = NUM_TAG_ACB;
+    }
+    else
+        num_mul(res, self, other);
+}
+
+static inline double
+num_real_d_inline (const num_t self)
+{
+    const struct num * _self = self;
+    arb_srcptr re = acb_realref(_self -> dat);
+    const double d = arf_get_d(arb_midref(re), ARF_RND_NEAR);
+
+    /* num_real_d() raises the flags of a NaN or an inaccurate ball */
+    if (d != d
+        || (!mag_is_zero(arb_radref(re)) && arb_rel_accuracy_bits(re) < NUM_PRECISION_MIN_BITS))
+        return num_real_d(self);
+    return d;
+}
+
+static inline bool
+num_is_zero_inline (const num_t self)
+{
+    const struct num * _self = self;
+    return acb_is_zero(_self -> dat) != 0;
+}
+
+#endif /* __NUM_INLINE_H__ */
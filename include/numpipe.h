@@ -0,0 +1,120 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numpipe.h
+ * @brief Interface of the streaming pipelines.
+ * @details A pipeline moves a stream of values, chunk by chunk, from a
+ * source through a sequence of stages to a sink. The chunks live in a fixed
+ * set of buffers of values allocated once, which circulate between the
+ * steps through bounded queues; the source, each stage and the sink run on
+ * their own thread, so that reading, computing and writing overlap.
+ *
+ * Pipelines are created with
+ * @code
+ * numpipe_t p = new(numpipe, chunk, nbuffers);
+ * @endcode
+ * where \p chunk is the number of values per buffer and \p nbuffers (at
+ * least 1) the number of buffers in flight, both size_t.
+ *
+ * The source and the stages run on threads prepared with
+ * num_thread_init(), in the default arithmetic mode, and the sink on the
+ * calling thread. Each step sees the chunks in the order of the stream.
+ */
+#ifndef __NUMPIPE_H__
+#define __NUMPIPE_H__
+
+#include <stddef.h>
+
+#include "num.h"
+
+/**
+ * This should be used in the initialization of the variable
+ */
+extern const void * numpipe;
+
+/**
+ * Type associated with the class
+ */
+typedef void * numpipe_t;
+
+/**
+ * Source of the stream: sets up to \p max values of \p chunk and returns
+ * how many were set, 0 meaning the end of the stream.
+ */
+typedef size_t (* numpipe_source_t) (num_t* chunk, const size_t max, void * ctx);
+
+/**
+ * Stage of the pipeline: transforms the \p n values of \p chunk in place.
+ */
+typedef void (* numpipe_stage_t) (num_t* chunk, const size_t n, void * ctx);
+
+/**
+ * Sink of the stream: consumes the \p n values of \p chunk.
+ */
+typedef void (* numpipe_sink_t) (const num_t* chunk, const size_t n, void * ctx);
+
+/**
+ * Work done by one step of a pipeline during the last numpipe_run().
+ */
+struct numpipe_stats
+{
+    /** Number of chunks handled */
+    size_t chunks;
+    /** Number of values handled */
+    size_t values;
+    /** Time spent in the callback, in seconds, waits excluded */
+    double seconds;
+};
+
+/**
+ * Appends a stage, called with \p ctx, to the pipeline.
+ */
+void
+numpipe_add_stage (numpipe_t self, numpipe_stage_t stage, void * ctx);
+
+/**
+ * Returns the number of stages of the pipeline.
+ */
+size_t
+numpipe_nstages (const numpipe_t self);
+
+/**
+ * Streams the values of \p source through the stages into \p sink, and
+ * returns when the sink has consumed the whole stream. Returns the number
+ * of values streamed.
+ */
+size_t
+numpipe_run (numpipe_t self, numpipe_source_t source, void * source_ctx,
+             numpipe_sink_t sink, void * sink_ctx);
+
+/**
+ * Sets \p stats to the work done by step \p k in the last run: 0 is the
+ * source, 1 to numpipe_nstages() the stages, and numpipe_nstages() + 1 the
+ * sink.
+ */
+void
+numpipe_stats (const numpipe_t self, const size_t k, struct numpipe_stats* stats);
+
+/**
+ * Prints the throughput of every step of the last run, in values per
+ * second.
+ */
+void
+numpipe_print_stats (const numpipe_t self);
+
+#endif /* __NUMPIPE_H__ */
@@ -0,0 +1,71 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numprof.h
+ * @brief Interface of the latency profiler.
+ * @details When the library is built with
+ * @code
+ * make PROFILE=1
+ * @endcode
+ * the calls to the functions listed in src/profile.c made from any object
+ * file but num.c are timed, and their latencies are recorded in histograms,
+ * one per function and per magnitude class of the arguments. These are the
+ * arithmetic functions, with their _d, _si, _ui and _c forms and the
+ * num_d_div(), num_si_div() and num_c_div() divisions; the elementary and
+ * special functions, including num_sin_cos(), num_sinh_cosh(),
+ * num_sin_cos_pi(), num_hyp1f1() and num_hyp2f1(); and num_real(),
+ * num_imag(), num_mid(), num_max(), num_max3() and num_union(). The
+ * setters, predicates, comparisons and conversions, the _vec forms and the
+ * functions of the library state are not timed; the calls a _vec form makes
+ * are inside num.c, and so are not seen either. The calls made by the other
+ * modules of the library (numsolve, numquad, numser, ...) are timed, so that
+ * a profile of a solver shows the functions it calls. Without PROFILE=1
+ * nothing is recorded and the functions below see empty histograms.
+ *
+ * Each thread records into its own histograms, which are merged when the
+ * thread exits and when they are dumped; a call waits for no other call,
+ * only for a dump or a reset in progress.
+ *
+ * The magnitude class of a call is that of its largest argument \f$|x|\f$:
+ * "zero", "tiny" (\f$|x| < 2^{-20}\f$), "small" (below 1), "unit" (below
+ * 16), "large" (below \f$2^{20}\f$), "huge", or "nonfinite". The histograms
+ * have four buckets per power of two of nanoseconds, so that a latency is
+ * known within 19%.
+ */
+#ifndef __NUMPROF_H__
+#define __NUMPROF_H__
+
+#include <stdio.h>
+
+/**
+ * Writes the histograms recorded so far by all the threads, live or exited,
+ * to \p out as a JSON object: a list of the (function, class) pairs called,
+ * each with its number of calls, its mean, median, 99th percentile and
+ * largest latencies in nanoseconds, and its non-empty buckets as [lower
+ * bound in ns, count] pairs.
+ */
+void
+num_profile_dump (FILE* out);
+
+/**
+ * Empties all the histograms, those of every thread.
+ */
+void
+num_profile_reset (void);
+
+#endif /* __NUMPROF_H__ */
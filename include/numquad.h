@@ -0,0 +1,78 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numquad.h
+ * @brief Interface of the numerical integration routines.
+ * @details The integrand is a ::num_func_t, \f$f(x)\f$, and the routines
+ * compute \f$\int_a^b f(x)\,dx\f$.
+ */
+#ifndef __NUMQUAD_H__
+#define __NUMQUAD_H__
+
+#include "num.h"
+
+enum num_quad_status
+{
+    NUM_QUAD_OK = 0,
+    /** The tolerance was not reached within the allowed evaluations */
+    NUM_QUAD_MAXEVAL
+};
+
+/**
+ * Integrates \p f with the \p n-point Gauss-Legendre rule.
+ *
+ * The nodes and weights are computed once per \p n and cached for the
+ * lifetime of the process. The \p n integrand values are evaluated as one
+ * batch, split among \p nthreads threads; \p f must then be safe to call
+ * concurrently. The limits may be complex, the path being the segment
+ * joining them. The result does not depend on \p nthreads.
+ */
+void
+num_quad_gl (num_t res, num_func_t f, void * ctx,
+             const num_t a, const num_t b, const int n, const int nthreads);
+
+/**
+ * Integrates \p f over the real interval \f$[a, b]\f$ with the adaptive
+ * 15-point Gauss-Kronrod rule, working on the midpoints in double precision.
+ *
+ * Intervals are bisected until the estimated error is below \p abstol or
+ * \p reltol times the modulus of the integral, or until a bisection, which
+ * takes 30 evaluations, would exceed \p maxeval evaluations; the first rule
+ * always takes 15. The evaluations are made one after the other in the
+ * calling thread.
+ */
+int
+num_quad_gk (num_t res, num_func_t f, void * ctx,
+             const num_t a, const num_t b,
+             const double abstol, const double reltol, const int maxeval);
+
+/**
+ * Integrates \p f along the segment from \p a to \p b with
+ * acb_calc_integrate(), so that \p res is a ball containing the integral.
+ *
+ * The enclosure is only valid if \p f is holomorphic on a neighborhood of
+ * the path and returns enclosures when evaluated on balls, which holds for
+ * integrands built from entire functions such as num_exp(), num_sin() or
+ * num_erf(). Integrands with branch cuts (num_log(), num_sqrt(), num_pow())
+ * should use num_quad_gk() instead.
+ */
+int
+num_quad_rigorous (num_t res, num_func_t f, void * ctx,
+                   const num_t a, const num_t b, const double abstol);
+
+#endif /* __NUMQUAD_H__ */
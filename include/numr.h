@@ -0,0 +1,409 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numr.h
+ * @brief Interface of the real numbers.
+ * @details A numr holds a single real ball (an arb_t) where a num holds two,
+ * so it takes about half the memory, and its functions call the real
+ * kernels of Arb directly. Every scalar function of num.h that makes sense
+ * on reals has a numr counterpart with the same semantics; left out are the
+ * complex-only functions (conj, arg, imag, exp_pi_i, the _c forms, ...), the
+ * vector forms (_vec), and the functions acting on the library state
+ * (modes, flags, constants, threads), which are shared with num. The
+ * functions defined only on part of the real line (sqrt, log, ...) return
+ * an indeterminate ball outside of it. The arithmetic is always that of
+ * balls: numr ignores num_set_mode().
+ *
+ * Real numbers are created with
+ * @code
+ * numr_t x = new(numr);
+ * @endcode
+ * and are converted to and from num with numr_set_num() and num_set_numr(),
+ * or mixed with them by the num_*_numr() functions.
+ */
+#ifndef __NUMR_H__
+#define __NUMR_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "num.h"
+
+/**
+ * This should be used in the initialization of the variable
+ */
+extern const void * numr;
+
+/**
+ * Type associated with the class
+ */
+typedef void * numr_t;
+
+/**
+ * Creates \p n real numbers, set to zero, in a single allocation, as
+ * num_new_array() does for num.
+ */
+numr_t *
+numr_new_array (const size_t n);
+
+/**
+ * Releases the \p n real numbers created by numr_new_array().
+ */
+void
+numr_delete_array (numr_t * arr, const size_t n);
+
+/**
+ * Returns the number of bytes taken by \p self, as num_memory_usage().
+ */
+size_t
+numr_memory_usage (const numr_t self);
+
+void
+numr_print (const numr_t self, const bool endline);
+
+/******************/
+/* Interoperation */
+/******************/
+
+/**
+ * Sets \p self to the real part of \p x, raising NUM_FLAG_NONREAL if \p x
+ * is not real.
+ */
+void
+numr_set_num (numr_t self, const num_t x);
+
+/**
+ * Sets \p self to \p x, with a zero imaginary part.
+ */
+void
+num_set_numr (num_t self, const numr_t x);
+
+/**
+ * Sets \p res to the sum of the complex \p self and the real \p other.
+ */
+void
+num_add_numr (num_t res, const num_t self, const numr_t other);
+
+void
+num_sub_numr (num_t res, const num_t self, const numr_t other);
+
+void
+num_mul_numr (num_t res, const num_t self, const numr_t other);
+
+void
+num_div_numr (num_t res, const num_t self, const numr_t other);
+
+/**********************/
+/* Basic manipulation */
+/**********************/
+
+void
+numr_zero (numr_t self);
+
+void
+numr_one (numr_t self);
+
+void
+numr_set (numr_t self, const numr_t other);
+
+void
+numr_set_d (numr_t self, const double x);
+
+void
+numr_set_si (numr_t self, const long x);
+
+void
+numr_set_ui (numr_t self, const unsigned long x);
+
+void
+numr_set_fmpz (numr_t self, const fmpz_t x);
+
+void
+numr_set_q (numr_t self, const fmpq_t x);
+
+/**
+ * Sets \p self to the real number written in \p str, in the syntax and
+ * with the rounding of num_set_str() without the complex forms, and returns
+ * false, leaving \p self unchanged, if \p str is not one.
+ */
+bool
+numr_set_str (numr_t self, const char* str);
+
+/**************/
+/* Predicates */
+/**************/
+
+bool
+numr_is_zero (const numr_t self);
+
+bool
+numr_is_identical (const numr_t self, const numr_t other);
+
+/*************************/
+/* Ball radius and casts */
+/*************************/
+
+double
+numr_rad_d (const numr_t self);
+
+long
+numr_rel_accuracy_bits (const numr_t self);
+
+void
+numr_mid (numr_t res, const numr_t self);
+
+double
+numr_to_d (const numr_t self);
+
+/********************/
+/* Unary operations */
+/********************/
+
+void
+numr_abs (numr_t res, const numr_t self);
+
+void
+numr_neg (numr_t res, const numr_t self);
+
+void
+numr_inv (numr_t res, const numr_t self);
+
+/**
+ * Sets \p res to the ceiling of the midpoint of \p self, as num_ceil().
+ */
+void
+numr_ceil (numr_t res, const numr_t self);
+
+void
+numr_sqrt (numr_t res, const numr_t self);
+
+void
+numr_rsqrt (numr_t res, const numr_t self);
+
+void
+numr_cbrt (numr_t res, const numr_t self);
+
+void
+numr_exp (numr_t res, const numr_t self);
+
+void
+numr_expm1 (numr_t res, const numr_t self);
+
+void
+numr_log (numr_t res, const numr_t self);
+
+void
+numr_log1p (numr_t res, const numr_t self);
+
+void
+numr_sin (numr_t res, const numr_t self);
+
+void
+numr_cos (numr_t res, const numr_t self);
+
+void
+numr_tan (numr_t res, const numr_t self);
+
+void
+numr_sinh (numr_t res, const numr_t self);
+
+void
+numr_cosh (numr_t res, const numr_t self);
+
+void
+numr_atan (numr_t res, const numr_t self);
+
+void
+numr_asin (numr_t res, const numr_t self);
+
+void
+numr_acos (numr_t res, const numr_t self);
+
+void
+numr_atan2 (numr_t res, const numr_t y, const numr_t x);
+
+void
+numr_sin_cos (numr_t s, numr_t c, const numr_t self);
+
+void
+numr_sin_cos_pi (numr_t s, numr_t c, const numr_t self);
+
+void
+numr_sinh_cosh (numr_t s, numr_t c, const numr_t self);
+
+/*********************/
+/* Binary operations */
+/*********************/
+
+void
+numr_add (numr_t res, const numr_t self, const numr_t other);
+
+void
+numr_add_d (numr_t res, const numr_t self, const double other);
+
+void
+numr_add_si (numr_t res, const numr_t self, const long other);
+
+void
+numr_sub (numr_t res, const numr_t self, const numr_t other);
+
+void
+numr_sub_d (numr_t res, const numr_t self, const double other);
+
+void
+numr_sub_si (numr_t res, const numr_t self, const long other);
+
+void
+numr_mul (numr_t res, const numr_t self, const numr_t other);
+
+void
+numr_mul_d (numr_t res, const numr_t self, const double other);
+
+void
+numr_mul_si (numr_t res, const numr_t self, const long other);
+
+/**
+ * Sets \p res to \f$x \cdot 2^e\f$, exactly.
+ */
+void
+numr_mul_2exp (numr_t res, const numr_t self, const long e);
+
+void
+numr_div (numr_t res, const numr_t self, const numr_t other);
+
+void
+numr_div_d (numr_t res, const numr_t self, const double other);
+
+void
+numr_div_si (numr_t res, const numr_t self, const long other);
+
+void
+numr_div_ui (numr_t res, const numr_t self, const unsigned long other);
+
+/**
+ * Sets \p res to the remainder of the midpoints, as num_fmod().
+ */
+void
+numr_fmod (numr_t res, const numr_t self, const numr_t other);
+
+/**
+ * Sets \p res to \f$x^y\f$; a negative \f$x\f$ needs an exact integer
+ * \f$y\f$.
+ */
+void
+numr_pow (numr_t res, const numr_t self, const numr_t other);
+
+void
+numr_pow_d (numr_t res, const numr_t self, const double other);
+
+void
+numr_pow_si (numr_t res, const numr_t self, const long other);
+
+/***********/
+/* Logical */
+/***********/
+
+bool
+numr_eq (const numr_t self, const numr_t other);
+
+bool
+numr_lt (const numr_t self, const numr_t other);
+
+bool
+numr_gt (const numr_t self, const numr_t other);
+
+bool
+numr_le (const numr_t self, const numr_t other);
+
+bool
+numr_ge (const numr_t self, const numr_t other);
+
+bool
+numr_eq_d (const numr_t self, const double other);
+
+bool
+numr_gt_d (const numr_t self, const double other);
+
+bool
+numr_ge_d (const numr_t self, const double other);
+
+bool
+numr_le_d (const numr_t self, const double other);
+
+/*********************/
+/* Special functions */
+/*********************/
+
+void
+numr_erf (numr_t res, const numr_t self);
+
+void
+numr_erfc (numr_t res, const numr_t self);
+
+void
+numr_gamma (numr_t res, const numr_t self);
+
+void
+numr_rgamma (numr_t res, const numr_t self);
+
+void
+numr_lgamma (numr_t res, const numr_t self);
+
+void
+numr_digamma (numr_t res, const numr_t self);
+
+void
+numr_bessel_j (numr_t res, const numr_t nu, const numr_t z);
+
+void
+numr_bessel_y (numr_t res, const numr_t nu, const numr_t z);
+
+void
+numr_bessel_i (numr_t res, const numr_t nu, const numr_t z);
+
+void
+numr_bessel_k (numr_t res, const numr_t nu, const numr_t z);
+
+void
+numr_expint (numr_t res, const numr_t s, const numr_t z);
+
+void
+numr_incgamma (numr_t res, const numr_t s, const numr_t z);
+
+void
+numr_hyp1f1 (numr_t res, const numr_t a, const numr_t b, const numr_t z);
+
+void
+numr_hyp2f1 (numr_t res, const numr_t a, const numr_t b, const numr_t c, const numr_t z);
+
+/**
+ * Sets \p res to a ball containing the larger of \p self and \p other.
+ */
+void
+numr_max (numr_t res, const numr_t self, const numr_t other);
+
+void
+numr_max3 (numr_t res, const numr_t self, const numr_t other, const numr_t another);
+
+/**
+ * Sets \p res to a ball containing both \p self and \p other.
+ */
+void
+numr_union (numr_t res, const numr_t self, const numr_t other);
+
+#endif /* __NUMR_H__ */
@@ -0,0 +1,162 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numser.h
+ * @brief Interface of the truncated power series, for automatic
+ * differentiation.
+ * @details A series holds the Taylor coefficients
+ * \f$f(x_0), f'(x_0), f''(x_0)/2!, \ldots\f$ of a function at a point, up to
+ * a fixed length. Starting from numser_set_var() and applying the functions
+ * below, which mirror those of num.h, gives the value and the derivatives of
+ * the composition in one pass, without finite differences.
+ *
+ * Series are created with
+ * @code
+ * numser_t f = new(numser, len);
+ * @endcode
+ * where \p len (int, at least 1) is the number of coefficients kept; 2 gives
+ * the value and the first derivative. Every result is truncated to the
+ * length of the series receiving it.
+ */
+#ifndef __NUMSER_H__
+#define __NUMSER_H__
+
+#include "num.h"
+
+/**
+ * This should be used in the initialization of the variable
+ */
+extern const void * numser;
+
+/**
+ * Type associated with the class
+ */
+typedef void * numser_t;
+
+/**
+ * Returns the number of coefficients kept by \p self.
+ */
+long
+numser_len (const numser_t self);
+
+void
+numser_set (numser_t self, const numser_t other);
+
+/**
+ * Sets \p self to the constant \p x.
+ */
+void
+numser_set_num (numser_t self, const num_t x);
+
+/**
+ * Sets \p self to the independent variable at the point \p x, that is to
+ * \f$x + t\f$.
+ */
+void
+numser_set_var (numser_t self, const num_t x);
+
+/**
+ * Sets \p res to the coefficient of \f$t^k\f$ in \p self, or to zero for a
+ * negative \p k or beyond its length.
+ */
+void
+numser_coeff (num_t res, const numser_t self, const long k);
+
+/**
+ * Sets \p res to the \p k-th derivative held by \p self, \f$k!\f$ times its
+ * coefficient of \f$t^k\f$, or zero for a negative \p k.
+ */
+void
+numser_deriv (num_t res, const numser_t self, const long k);
+
+/**************/
+/* Arithmetic */
+/**************/
+
+void
+numser_neg (numser_t res, const numser_t self);
+
+void
+numser_add (numser_t res, const numser_t self, const numser_t other);
+
+void
+numser_add_num (numser_t res, const numser_t self, const num_t other);
+
+void
+numser_sub (numser_t res, const numser_t self, const numser_t other);
+
+void
+numser_mul (numser_t res, const numser_t self, const numser_t other);
+
+void
+numser_mul_num (numser_t res, const numser_t self, const num_t other);
+
+/**
+ * Sets \p res to \f$self / other\f$; the constant term of \p other must not
+ * contain zero.
+ */
+void
+numser_div (numser_t res, const numser_t self, const numser_t other);
+
+/**
+ * Sets \p res to \f$self^{other}\f$.
+ */
+void
+numser_pow (numser_t res, const numser_t self, const numser_t other);
+
+/**
+ * Sets \p res to \f$self^{other}\f$, for a constant exponent.
+ */
+void
+numser_pow_num (numser_t res, const numser_t self, const num_t other);
+
+/*******************/
+/* Unary functions */
+/*******************/
+
+void
+numser_sqrt (numser_t res, const numser_t self);
+
+void
+numser_exp (numser_t res, const numser_t self);
+
+void
+numser_log (numser_t res, const numser_t self);
+
+void
+numser_sin (numser_t res, const numser_t self);
+
+void
+numser_cos (numser_t res, const numser_t self);
+
+void
+numser_atan (numser_t res, const numser_t self);
+
+void
+numser_erf (numser_t res, const numser_t self);
+
+void
+numser_gamma (numser_t res, const numser_t self);
+
+void
+numser_rgamma (numser_t res, const numser_t self);
+
+void
+numser_lgamma (numser_t res, const numser_t self);
+
+#endif /* __NUMSER_H__ */
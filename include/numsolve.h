@@ -0,0 +1,108 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numsolve.h
+ * @brief Interface of the root finders and minimizers.
+ * @details All the routines allocate their temporaries once, before
+ * iterating, and return one of the ::num_solve_status codes.
+ */
+#ifndef __NUMSOLVE_H__
+#define __NUMSOLVE_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "num.h"
+
+enum num_solve_status
+{
+    NUM_SOLVE_OK = 0,
+    /** The function has the same sign at both ends of the interval */
+    NUM_SOLVE_NO_BRACKET,
+    /** The sign of the function could not be decided at some point */
+    NUM_SOLVE_UNCERTAIN,
+    /** The derivative vanished at some iterate */
+    NUM_SOLVE_ZERO_DERIVATIVE,
+    /** The tolerance was not reached within the allowed iterations */
+    NUM_SOLVE_MAXITER
+};
+
+/**
+ * Finds a root of the real function \p f in \f$[a, b]\f$ by bisection.
+ *
+ * Every sign is decided on the Arb ball of \f$f\f$, so \p root is a ball
+ * certified to contain a root as long as \p f is continuous. The interval is
+ * halved until its width is below \p tol; if the sign at a midpoint cannot
+ * be decided, the enclosure reached so far is returned along with
+ * ::NUM_SOLVE_UNCERTAIN.
+ */
+int
+num_solve_bisect (num_t root, num_func_t f, void * ctx,
+                  const num_t a, const num_t b, const double tol, const int maxiter);
+
+/**
+ * Finds a root of the real function \p f in \f$[a, b]\f$ by Brent's method,
+ * working on the midpoints in double precision.
+ */
+int
+num_solve_brent (num_t root, num_func_t f, void * ctx,
+                 const num_t a, const num_t b, const double tol, const int maxiter);
+
+/**
+ * Finds a root of \p f, real or complex, by Newton's method started at \p
+ * x0. \p df is the derivative of \p f. The iteration stops when the modulus
+ * of the step is below \p tol.
+ */
+int
+num_solve_newton (num_t root, num_func_t f, num_func_t df, void * ctx,
+                  const num_t x0, const double tol, const int maxiter);
+
+/**
+ * Finds a root of \p f by Halley's method, given its first two derivatives
+ * \p df and \p d2f.
+ */
+int
+num_solve_halley (num_t root, num_func_t f, num_func_t df, num_func_t d2f, void * ctx,
+                  const num_t x0, const double tol, const int maxiter);
+
+/**
+ * Solves \p n independent problems by Newton's method.
+ *
+ * Problem \p i uses the context \p ctx[i] (or NULL when \p ctx is NULL) and
+ * starts at \p x0[i]. All the active problems advance one step per sweep.
+ * \p status[i] receives the ::num_solve_status of problem \p i: once it
+ * reaches the tolerance (::NUM_SOLVE_OK) or its derivative vanishes
+ * (::NUM_SOLVE_ZERO_DERIVATIVE, \p roots[i] being the last iterate) it is
+ * not iterated further, and it is ::NUM_SOLVE_MAXITER if neither happened.
+ *
+ * Returns the number of converged problems.
+ */
+size_t
+num_solve_newton_vec (num_t* roots, int* status, num_func_t f, num_func_t df,
+                      void * const * ctx, const num_t* x0, const size_t n,
+                      const double tol, const int maxiter);
+
+/**
+ * Finds a minimum of the real function \p f in \f$[a, b]\f$ by golden
+ * section search, working on the midpoints in double precision.
+ */
+int
+num_minimize_golden (num_t xmin, num_func_t f, void * ctx,
+                     const num_t a, const num_t b, const double tol, const int maxiter);
+
+#endif /* __NUMSOLVE_H__ */
@@ -0,0 +1,83 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numtab.h
+ * @brief Interface of the interpolation tables for real functions.
+ * @details A table approximates a real function of one real variable on a
+ * fixed interval \f$[a, b]\f$ by piecewise Chebyshev polynomials. The
+ * coefficients are computed once, at construction, from the Arb-backed
+ * routines of num.h; evaluation then runs entirely in machine doubles.
+ *
+ * Tables are created with
+ * @code
+ * numtab_t t = new(numtab, num_erf, a, b, pieces, degree);
+ * @endcode
+ * where \p pieces is the number of equally spaced subintervals and \p
+ * degree the degree of the polynomial on each of them (both int).
+ */
+#ifndef __NUMTAB_H__
+#define __NUMTAB_H__
+
+#include <stddef.h>
+
+#include "num.h"
+
+/**
+ * This should be used in the initialization of the variable
+ */
+extern const void * numtab;
+
+/**
+ * Type associated with the class
+ */
+typedef void * numtab_t;
+
+/**
+ * Signature of the functions which can be tabulated, e.g. num_exp().
+ */
+typedef void (* num_unary_t) (num_t res, const num_t self);
+
+/**
+ * Evaluates the table at \p x.
+ *
+ * Outside of \f$[a, b]\f$ the tabulated function itself is called.
+ */
+double
+numtab_eval_d (const numtab_t self, const double x);
+
+/**
+ * Evaluates the table at the \p n points of \p x, storing the results in \p
+ * res.
+ */
+void
+numtab_eval_vec (const numtab_t self, double* res, const double* x, const size_t n);
+
+/**
+ * Returns an estimate of the largest absolute error of the table inside
+ * \f$[a, b]\f$.
+ *
+ * The error is sampled against the Arb reference at construction, on a grid
+ * four times denser than the interpolation nodes, and the largest sample is
+ * doubled as a margin. Between the samples the error may exceed it, so this
+ * is not a guaranteed bound; where one is needed, evaluate the function
+ * through num.h, whose balls enclose the result.
+ */
+double
+numtab_error_estimate (const numtab_t self);
+
+#endif /* __NUMTAB_H__ */
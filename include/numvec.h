@@ -0,0 +1,121 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numvec.h
+ * @brief Interface of the sorting, searching and selection kernels.
+ * @details The kernels order the values by the midpoints of their real
+ * parts, rounded to doubles, without calling num_lt() or num_gt(). This is
+ * the tie policy for balls: two overlapping balls are ordered by their
+ * midpoints, which need not be the order of the numbers they contain, and
+ * values with the same midpoint keep their original order. Imaginary parts
+ * are ignored; NaN midpoints sort after everything else.
+ *
+ * The vectors are arrays of ::num_t; the sorts permute the pointers and
+ * never copy the values.
+ */
+#ifndef __NUMVEC_H__
+#define __NUMVEC_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "num.h"
+
+/**
+ * Sorts the \p n values \p x in increasing order, stably.
+ *
+ * Large arrays are cut in up to \p nthreads chunks which are sorted in
+ * parallel and then merged.
+ */
+void
+numvec_sort (num_t* x, const size_t n, const int nthreads);
+
+/**
+ * Sets \p perm to the permutation which sorts \p x, so that \p x[perm[0]],
+ * \p x[perm[1]], ... is increasing; \p x is left untouched.
+ */
+void
+numvec_argsort (size_t* perm, const num_t* x, const size_t n, const int nthreads);
+
+/**
+ * Reorders \p x so that \p x[k] is the value it would hold if \p x were
+ * sorted, with no greater value before it and no smaller value after it.
+ */
+void
+numvec_nth_element (num_t* x, const size_t k, const size_t n);
+
+/**
+ * Returns the first position of the sorted vector \p x at which \p v could
+ * be inserted keeping the order, that is the number of values smaller than
+ * \p v.
+ */
+size_t
+numvec_searchsorted (const num_t* x, const size_t n, const num_t v);
+
+/*********/
+/* Masks */
+/*********/
+
+/*
+ * A mask over n values is an array of (n + 63) / 64 words, value i being
+ * selected when bit i % 64 of word i / 64 is set; the bits beyond n are
+ * cleared. The predicates have the semantics of their num.h counterparts,
+ * the comparisons ignoring the imaginary parts.
+ */
+
+/**
+ * Sets \p mask to the values of \p x which are real.
+ */
+void
+numvec_is_real_mask (uint64_t* mask, const num_t* x, const size_t n);
+
+/**
+ * Sets \p mask to the values of \p x which are exactly zero.
+ */
+void
+numvec_is_zero_mask (uint64_t* mask, const num_t* x, const size_t n);
+
+/**
+ * Sets \p mask to the positions where \p x is certainly less than \p y, as
+ * num_lt() decides.
+ */
+void
+numvec_lt_mask (uint64_t* mask, const num_t* x, const num_t* y, const size_t n);
+
+/**
+ * Sets \p mask to the values of \p x certainly less than \p v.
+ */
+void
+numvec_lt_d_mask (uint64_t* mask, const num_t* x, const size_t n, const double v);
+
+/**
+ * Returns the number of values selected by \p mask.
+ */
+size_t
+numvec_mask_count (const uint64_t* mask, const size_t n);
+
+/**
+ * Copies to \p dst, in order, the pointers of the values of \p src selected
+ * by \p mask, and returns their number. As the sorts, it moves pointers and
+ * never copies the values. \p dst must have room for \p n pointers, the
+ * copy being done without branches.
+ */
+size_t
+numvec_compress (num_t* dst, const num_t* src, const uint64_t* mask, const size_t n);
+
+#endif /* __NUMVEC_H__ */
@@ -0,0 +1,123 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file const.c
+ * @brief Implementation of the cached mathematical constants.
+ * @details Arb caches its constants per thread, so every new thread pays for
+ * computing them again. Here each constant is kept once for the process, at
+ * the largest precision asked so far, and lower precisions are obtained by
+ * rounding it. The cache is shared by all the threads under a mutex, and is
+ * never released.
+ */
+#include <pthread.h>
+
+#include "num.h"
+#include "num_private.h"
+
+#include <arb.h>
+
+enum num_const
+{
+    CONST_PI,
+    CONST_E,
+    CONST_LOG2,
+    CONST_EULER,
+    CONST_CATALAN,
+    NCONSTS
+};
+
+static void (* const compute[NCONSTS]) (arb_t, slong) =
+{
+    arb_const_pi, arb_const_e, arb_const_log2, arb_const_euler, arb_const_catalan
+};
+
+/* The value of each constant, valid once its precision is positive */
+static arb_struct cache[NCONSTS];
+static slong cache_prec[NCONSTS];
+
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Sets res to constant c rounded to prec bits, computing it if needed */
+static void
+get_const (arb_t res, const enum num_const c, const slong prec)
+{
+    pthread_mutex_lock(&cache_lock);
+    if (cache_prec[c] < prec)
+    {
+        if (cache_prec[c] == 0) arb_init(&cache[c]);
+        compute[c](&cache[c], prec);
+        cache_prec[c] = prec;
+    }
+    arb_set_round(res, &cache[c], prec);
+    pthread_mutex_unlock(&cache_lock);
+}
+
+static void
+set_const (num_t res, const enum num_const c)
+{
+    struct num * _res = num_writable_(res);
+
+    get_const(acb_realref(_res -> dat), c, PREC);
+    arb_zero(acb_imagref(_res -> dat));
+}
+
+/****************************/
+/* User interface functions */
+/****************************/
+
+void
+num_const_pi (num_t res)
+{
+    set_const(res, CONST_PI);
+}
+
+void
+num_const_e (num_t res)
+{
+    set_const(res, CONST_E);
+}
+
+void
+num_const_log2 (num_t res)
+{
+    set_const(res, CONST_LOG2);
+}
+
+void
+num_const_euler (num_t res)
+{
+    set_const(res, CONST_EULER);
+}
+
+void
+num_const_catalan (num_t res)
+{
+    set_const(res, CONST_CATALAN);
+}
+
+void
+num_const_warmup (const long prec)
+{
+    arb_t t;
+    int c;
+
+    arb_init(t);
+    for (c = 0; c < NCONSTS; c++)
+        get_const(t, c, (prec > PREC) ? prec : PREC);
+    arb_clear(t);
+}
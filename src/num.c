@@ -19,7 +19,6 @@
  * @file num.c
  * @brief Implementation of the Abstract Data Type (ADT).
  */
-#include <assert.h>
 #include <math.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -29,19 +28,14 @@
 #include "abc.h"
 #include "new.h"
 #include "num.h"
+#include "num_private.h"
 
 #include <arb.h>
 #include <acb.h>
 #include <acb_hypgeom.h>
 
-#define PREC 53
-#define UNUSED(x) (void)(x)
-
-struct num
-{
-    const void * class; /* must be first */
-    acb_t dat;
-};
+/* Largest double exponent handed to acb_pow_si by num_pow_d() */
+#define POW_SI_MAX 9007199254740992.0
 
 static void *
 num_ctor (void * self, va_list * app)
@@ -49,6 +43,7 @@ num_ctor (void * self, va_list * app)
     UNUSED(app);
     struct num * _self = self;
     acb_init(_self -> dat);
+    _self -> tag = NUM_TAG_ACB;
     return _self;
 }
 
@@ -68,6 +63,49 @@ static const struct ABC _num =
 
 const void * num = & _num;
 
+FLINT_TLS_PREFIX int num_thread_mode = NUM_MODE_BALL;
+
+/* Sticky exception flags of the thread, see num_test_flags() */
+static FLINT_TLS_PREFIX int num_thread_flags = 0;
+
+/*
+ * The block holds the n pointers followed by the n objects. The objects
+ * start at a multiple of the size of a pointer, and struct num (a pointer,
+ * the limbs of Arb and an int) needs no stricter alignment than a pointer,
+ * so they stay aligned. calloc() fails if the size of the block overflows.
+ */
+num_t *
+num_new_array (const size_t n)
+{
+    num_t * arr = calloc(n, sizeof(num_t) + sizeof(struct num));
+    struct num * o;
+    size_t i;
+
+    if (arr == NULL) return NULL;
+    o = (struct num *) (arr + n);
+    for (i = 0; i < n; i++)
+    {
+        o[i].class = num;
+        acb_init(o[i].dat);
+        o[i].tag = NUM_TAG_ACB;
+        arr[i] = &o[i];
+    }
+    return arr;
+}
+
+void
+num_delete_array (num_t * arr, const size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        struct num * o = arr[i];
+        acb_clear(o -> dat);
+    }
+    free(arr);
+}
+
 // Converts an arb_t number to double.
 static double
 arbtod (const arb_t x)
@@ -75,6 +113,220 @@ arbtod (const arb_t x)
     return arf_get_d(arb_midref(x), ARF_RND_NEAR);
 }
 
+/* Converts x as arbtod(), raising NUM_FLAG_NAN or NUM_FLAG_PRECISION */
+double
+num_arbtod_checked_ (const arb_t x)
+{
+    const double d = arbtod(x);
+
+    if (d != d)
+        num_thread_flags |= NUM_FLAG_NAN;
+    else if (!mag_is_zero(arb_radref(x)) && arb_rel_accuracy_bits(x) < NUM_PRECISION_MIN_BITS)
+        num_thread_flags |= NUM_FLAG_PRECISION;
+    return d;
+}
+
+/* Raises NUM_FLAG_NONREAL unless x is real; tagged values always are */
+static void
+check_real (const struct num * x)
+{
+    if (x -> tag != NUM_TAG_SI && !arb_is_zero(acb_imagref(x -> dat)))
+        num_thread_flags |= NUM_FLAG_NONREAL;
+}
+
+/* Raises NUM_FLAG_DIVBYZERO if x is exactly zero */
+static void
+check_divisor (const struct num * x)
+{
+    if ((x -> tag == NUM_TAG_SI) ? x -> si == 0 : acb_is_zero(x -> dat))
+        num_thread_flags |= NUM_FLAG_DIVBYZERO;
+}
+
+/*
+ * Small integers: values tagged NUM_TAG_SI whose moduli are within these
+ * bounds are added or multiplied as machine integers without overflow.
+ */
+#define SI_ADD_MAX (WORD_MAX / 2)
+#define SI_MUL_MAX ((WORD(1) << (FLINT_BITS / 2 - 1)) - 1)
+
+static bool
+small_pair (const struct num * x, const struct num * y, const slong max)
+{
+    return x -> tag == NUM_TAG_SI && y -> tag == NUM_TAG_SI
+        && x -> si >= -max && x -> si <= max
+        && y -> si >= -max && y -> si <= max;
+}
+
+static void
+set_small (struct num * res, const slong x)
+{
+    acb_set_si(res -> dat, x);
+    res -> tag = NUM_TAG_SI, res -> si = x;
+}
+
+/* Tags o with x when x is a long other than WORD_MIN */
+static void
+tag_si (struct num * o, const long x)
+{
+    o -> tag = (x != WORD_MIN) ? NUM_TAG_SI : NUM_TAG_ACB;
+    o -> si = (x != WORD_MIN) ? x : 0;
+}
+
+/* Tags o with x when x is an integer of modulus below 2^(FLINT_BITS - 1) */
+static void
+tag_d (struct num * o, const double x)
+{
+    const bool small = (x == floor(x) && fabs(x) < -(double) WORD_MIN);
+
+    o -> tag = small ? NUM_TAG_SI : NUM_TAG_ACB;
+    o -> si = small ? (slong) x : 0;
+}
+
+/*
+ * Scalar operands of the _d, _si and _c forms live on the stack: Arb does not
+ * allocate for machine-size values, so these forms never touch the heap.
+ */
+static void
+scalar_d (struct num * o, const double x)
+{
+    o -> class = num;
+    acb_init(o -> dat);
+    acb_set_d(o -> dat, x);
+    tag_d(o, x);
+}
+
+static void
+scalar_si (struct num * o, const long x)
+{
+    o -> class = num;
+    acb_init(o -> dat);
+    acb_set_si(o -> dat, x);
+    tag_si(o, x);
+}
+
+static void
+scalar_c (struct num * o, const double complex x)
+{
+    o -> class = num;
+    acb_init(o -> dat);
+    acb_set_d_d(o -> dat, creal(x), cimag(x));
+    o -> tag = NUM_TAG_ACB, o -> si = 0;
+}
+
+static void
+scalar_clear (struct num * o)
+{
+    acb_clear(o -> dat);
+}
+
+/*
+ * Argument classes: real arguments of known sign stay on the real line, where
+ * the arb_* functions skip the imaginary parts, and powers with integer or
+ * half-integer exponents avoid the logarithm of acb_pow().
+ */
+
+/* Returns true if a * b fits in a tagged value */
+static bool
+si_mul_fits (const slong a, const slong b)
+{
+    const ulong ua = (a < 0) ? -(ulong) a : (ulong) a;
+    const ulong ub = (b < 0) ? -(ulong) b : (ulong) b;
+
+    return ub == 0 || ua <= (ulong) WORD_MAX / ub;
+}
+
+/* Sets r to b^n by repeated squaring, unless it does not fit */
+static bool
+si_pow (slong * r, slong b, ulong n)
+{
+    slong p = 1;
+
+    for (; n > 0; n >>= 1)
+    {
+        if (n & 1)
+        {
+            if (!si_mul_fits(p, b)) return false;
+            p *= b;
+        }
+        if (n > 1)
+        {
+            if (!si_mul_fits(b, b)) return false;
+            b *= b;
+        }
+    }
+    * r = p;
+    return true;
+}
+
+/* Returns true if y is exactly k / 2 for some |k| < 2^31, and sets k */
+static bool
+half_integer (slong * k, const arb_t y)
+{
+    arf_t t;
+
+    if (!arb_is_exact(y) || !arf_is_int_2exp_si(arb_midref(y), -1)
+        || arf_cmpabs_2exp_si(arb_midref(y), 30) >= 0)
+        return false;
+
+    arf_init(t);
+    arf_mul_2exp_si(t, arb_midref(y), 1);
+    * k = arf_get_si(t, ARF_RND_DOWN);
+    arf_clear(t);
+
+    return true;
+}
+
+static void
+sqrt_acb (acb_t res, const acb_t x)
+{
+    if (acb_is_real(x) && arb_is_nonnegative(acb_realref(x)))
+    {
+        arb_sqrt(acb_realref(res), acb_realref(x), PREC);
+        arb_zero(acb_imagref(res));
+    }
+    else
+        acb_sqrt(res, x, PREC);
+}
+
+static void
+pow_si_acb (acb_t res, const acb_t x, const slong n)
+{
+    if (acb_is_real(x))
+    {
+        arb_pow_ui(acb_realref(res), acb_realref(x), (n >= 0) ? (ulong) n : -(ulong) n, PREC);
+        if (n < 0) arb_inv(acb_realref(res), acb_realref(res), PREC);
+        arb_zero(acb_imagref(res));
+    }
+    else
+        acb_pow_si(res, x, n, PREC);
+}
+
+/* Sets res to x^y for a real y, which may be a part of res */
+static void
+pow_arb_acb (acb_t res, const acb_t x, const arb_t y)
+{
+    slong k;
+
+    if (half_integer(&k, y))
+    {
+        if (k % 2 == 0)
+            pow_si_acb(res, x, k / 2);
+        else
+        {
+            /* x^(k/2) = sqrt(x)^k on the principal branches */
+            sqrt_acb(res, x);
+            pow_si_acb(res, res, k);
+        }
+    }
+    else if (acb_is_real(x) && arb_is_positive(acb_realref(x)))
+    {
+        arb_pow(acb_realref(res), acb_realref(x), y, PREC);
+        arb_zero(acb_imagref(res));
+    }
+    else
+        acb_pow_arb(res, x, y, PREC);
+}
+
 /****************************/
 /* User interface functions */
 /****************************/
@@ -84,21 +336,19 @@ arbtod (const arb_t x)
 void
 num_zero(num_t self)
 {
-    struct num * _self = self;
-    acb_zero(_self -> dat);
+    set_small(self, 0);
 }
 
 void
 num_one(num_t self)
 {
-    struct num * _self = self;
-    acb_one(_self -> dat);
+    set_small(self, 1);
 }
 
 void
 num_onei(num_t self)
 {
-    struct num * _self = self;
+    struct num * _self = num_writable_(self);
     acb_onei(_self -> dat);
 }
 
@@ -108,12 +358,13 @@ num_set(num_t self, const num_t other)
     struct num * _self = self;
     const struct num * _other = other;
     acb_set(_self -> dat, _other -> dat);
+    _self -> tag = _other -> tag, _self -> si = _other -> si;
 }
 
 static void
 num_set_acb(num_t self, const acb_t other)
 {
-    struct num * _self = self;
+    struct num * _self = num_writable_(self);
     acb_set(_self -> dat, other);
 }
 
@@ -123,15 +374,47 @@ num_set_d(num_t self, const double x)
 {
     struct num * _self = self;
     acb_set_d(_self -> dat, x);
+    tag_d(_self, x);
 }
 
 void
 num_set_d_d(num_t self, const double x, const double y)
 {
-    struct num * _self = self;
+    struct num * _self = num_writable_(self);
     acb_set_d_d(_self -> dat, x, y);
 }
 
+void
+num_set_si(num_t self, const long x)
+{
+    struct num * _self = self;
+    acb_set_si(_self -> dat, x);
+    tag_si(_self, x);
+}
+
+void
+num_set_ui(num_t self, const unsigned long x)
+{
+    struct num * _self = self;
+    acb_set_ui(_self -> dat, x);
+    tag_si(_self, (x <= WORD_MAX) ? (slong) x : WORD_MIN);
+}
+
+void
+num_set_fmpz(num_t self, const fmpz_t x)
+{
+    struct num * _self = self;
+    acb_set_fmpz(_self -> dat, x);
+    tag_si(_self, fmpz_fits_si(x) ? fmpz_get_si(x) : WORD_MIN);
+}
+
+void
+num_set_q(num_t self, const fmpq_t x)
+{
+    struct num * _self = num_writable_(self);
+    acb_set_fmpq(_self -> dat, x, PREC);
+}
+
 /* Input and Output */
 void
 num_print (const num_t self, const bool endline)
@@ -148,7 +431,7 @@ num_print (const num_t self, const bool endline)
 void
 num_real (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
     
     arb_t x;
@@ -166,7 +449,7 @@ num_real_d (const num_t self)
     arb_t x;
     arb_init(x);
     acb_get_real(x, _self -> dat);
-    ret = arbtod(x);
+    ret = num_arbtod_checked_(x);
     arb_clear(x);
 
     return ret;
@@ -175,7 +458,7 @@ num_real_d (const num_t self)
 void
 num_imag (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
     
     arb_t x;
@@ -194,7 +477,7 @@ num_imag_d (const num_t self)
     arb_t x;
     arb_init(x);
     acb_get_imag(x, _self -> dat);
-    ret = arbtod(x);
+    ret = num_arbtod_checked_(x);
     arb_clear(x);
 
     return ret;
@@ -206,6 +489,8 @@ num_is_zero (const num_t self)
 {
     const struct num * _self = self;
 
+    if (_self -> tag == NUM_TAG_SI) return _self -> si == 0;
+
     const int res = acb_is_zero(_self -> dat);
 
     return (res != 0) ? true : false;
@@ -216,28 +501,92 @@ num_is_real (const num_t self)
 {
     const struct num * _self = self;
 
+    if (_self -> tag == NUM_TAG_SI) return true;
+
     const int res = acb_is_real(_self -> dat);
 
     return (res != 0) ? true : false;
 }
 
+bool
+num_is_identical (const num_t self, const num_t other)
+{
+    const struct num * _self = self;
+    const struct num * _other = other;
+
+    return acb_equal(_self -> dat, _other -> dat) != 0;
+}
+
+/* Ball radius and modes */
+
+void
+num_set_mode (const int mode)
+{
+    num_thread_mode = mode;
+}
+
+int
+num_get_mode (void)
+{
+    return num_thread_mode;
+}
+
+/* Exceptions */
+
+int
+num_test_flags (const int flags)
+{
+    return num_thread_flags & flags;
+}
+
+void
+num_clear_flags (const int flags)
+{
+    num_thread_flags &= ~flags;
+}
+
+void
+num_raise_flags_ (const int flags)
+{
+    num_thread_flags |= flags;
+}
+
+double
+num_rad_d (const num_t self)
+{
+    const struct num * _self = self;
+    const double re = mag_get_d(arb_radref(acb_realref(_self -> dat)));
+    const double im = mag_get_d(arb_radref(acb_imagref(_self -> dat)));
+
+    return (re > im) ? re : im;
+}
+
+long
+num_rel_accuracy_bits (const num_t self)
+{
+    const struct num * _self = self;
+    return acb_rel_accuracy_bits(_self -> dat);
+}
+
+void
+num_mid (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_get_mid(_res -> dat, _self -> dat);
+}
+
 /* /\* Type casting *\/ */
 
 double
 num_to_d (const num_t self)
 {
-    assert(num_is_real(self));
-
-    arb_t x;
     const struct num * _self = self;
-    double res;
 
-    arb_init(x);
-    acb_get_real(x, _self -> dat);
+    if (_self -> tag == NUM_TAG_SI) return (double) _self -> si;
 
-    res = arbtod(x);
-    
-    return res;
+    check_real(_self);
+    return num_arbtod_checked_(acb_realref(_self -> dat));
 }
 
 void
@@ -250,7 +599,7 @@ num_to_d_d (double* res, const num_t self)
     acb_get_real(x, _self -> dat);
     acb_get_imag(y, _self -> dat);
 
-    res[0] = arbtod(x), res[1] = arbtod(y);
+    res[0] = num_arbtod_checked_(x), res[1] = num_arbtod_checked_(y);
     arb_clear(x), arb_clear(y);
 }
 
@@ -259,8 +608,8 @@ double complex
 num_to_complex (const num_t self)
 {
     const struct num * _self = self;
-    const double re = arbtod(acb_realref(_self -> dat));
-    const double im = arbtod(acb_imagref(_self -> dat));
+    const double re = num_arbtod_checked_(acb_realref(_self -> dat));
+    const double im = num_arbtod_checked_(acb_imagref(_self -> dat));
 
     return re + im * I;
 }
@@ -271,6 +620,13 @@ num_abs (num_t res, const num_t self)
     struct num * _res = res;
     const struct num * _self = self;
 
+    if (_self -> tag == NUM_TAG_SI)
+    {
+        set_small(_res, (_self -> si < 0) ? -_self -> si : _self -> si);
+        return;
+    }
+
+    _res -> tag = NUM_TAG_ACB;
     arb_t x;
     arb_init(x);
     acb_abs(x, _self -> dat, PREC);
@@ -284,13 +640,15 @@ num_neg (num_t res, const num_t self)
     struct num * _res = res;
     const struct num * _self = self;
     acb_neg(_res -> dat, _self -> dat);
+    _res -> tag = _self -> tag, _res -> si = -_self -> si;
 }
 
 void
 num_inv (num_t res, const num_t self)
 {
-    struct num * _res = res;
     const struct num * _self = self;
+    check_divisor(_self);
+    struct num * _res = num_writable_(res);
     acb_inv(_res -> dat, _self -> dat, PREC);
 }
 
@@ -300,13 +658,13 @@ num_conj (num_t res, const num_t self)
     struct num * _res = res;
     const struct num * _self = self;
     acb_conj(_res -> dat, _self -> dat);
+    _res -> tag = _self -> tag, _res -> si = _self -> si;
 }
 
 void
 num_ceil (num_t res, const num_t self)
 {
-    assert(num_is_real(self));
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const double x = num_to_d(self);
     acb_set_d(_res -> dat, ceil(x));
 }
@@ -314,7 +672,7 @@ num_ceil (num_t res, const num_t self)
 void
 num_arg (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
 
     arb_t x;
@@ -327,31 +685,45 @@ num_arg (num_t res, const num_t self)
 void
 num_sqrt (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
-    acb_sqrt(_res -> dat, _self -> dat, PREC);
+    sqrt_acb(_res -> dat, _self -> dat);
 }
 
 void
 num_exp (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
-    acb_exp(_res -> dat, _self -> dat, PREC);
+
+    if (acb_is_real(_self -> dat))
+    {
+        arb_exp(acb_realref(_res -> dat), acb_realref(_self -> dat), PREC);
+        arb_zero(acb_imagref(_res -> dat));
+    }
+    else
+        acb_exp(_res -> dat, _self -> dat, PREC);
 }
 
 void
 num_log (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
-    acb_log(_res -> dat, _self -> dat, PREC);
+
+    if (acb_is_real(_self -> dat) && arb_is_positive(acb_realref(_self -> dat)))
+    {
+        arb_log(acb_realref(_res -> dat), acb_realref(_self -> dat), PREC);
+        arb_zero(acb_imagref(_res -> dat));
+    }
+    else
+        acb_log(_res -> dat, _self -> dat, PREC);
 }
 
 void
 num_sin (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
     acb_sin(_res -> dat, _self -> dat, PREC);
 }
@@ -359,7 +731,7 @@ num_sin (num_t res, const num_t self)
 void
 num_sinh (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
     acb_sinh(_res -> dat, _self -> dat, PREC);
 }
@@ -367,7 +739,7 @@ num_sinh (num_t res, const num_t self)
 void
 num_cos (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
     acb_cos(_res -> dat, _self -> dat, PREC);
 }
@@ -376,11 +748,277 @@ num_cos (num_t res, const num_t self)
 void
 num_cosh (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
     acb_cosh(_res -> dat, _self -> dat, PREC);
 }
 
+void
+num_tan (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_tan(_res -> dat, _self -> dat, PREC);
+}
+
+void
+num_atan (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_atan(_res -> dat, _self -> dat, PREC);
+}
+
+void
+num_asin (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_asin(_res -> dat, _self -> dat, PREC);
+}
+
+void
+num_acos (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_acos(_res -> dat, _self -> dat, PREC);
+}
+
+void
+num_atan2 (num_t res, const num_t y, const num_t x)
+{
+    const struct num * _y = y;
+    const struct num * _x = x;
+    check_real(_y), check_real(_x);
+    struct num * _res = num_writable_(res);
+
+    arb_t t;
+    arb_init(t);
+    arb_atan2(t, acb_realref(_y -> dat), acb_realref(_x -> dat), PREC);
+    acb_set_arb(_res -> dat, t);
+    arb_clear(t);
+}
+
+void
+num_log1p (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_log1p(_res -> dat, _self -> dat, PREC);
+}
+
+void
+num_expm1 (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_expm1(_res -> dat, _self -> dat, PREC);
+}
+
+/* Signed cube root of one endpoint, cbrt(-u) = -cbrt(u) */
+static void
+cbrt_arf (arb_t res, const arf_t u, slong prec)
+{
+    arb_set_arf(res, u);
+    if (arf_sgn(u) < 0)
+    {
+        arb_neg(res, res);
+        arb_root_ui(res, res, 3, prec);
+        arb_neg(res, res);
+    }
+    else
+        arb_root_ui(res, res, 3, prec);
+}
+
+/*
+ * Real cube root, odd in x. Arb only takes roots of nonnegative balls, so a
+ * ball straddling 0 is enclosed, cbrt being increasing, by the union of the
+ * roots of its endpoints.
+ */
+void
+num_cbrt_arb_ (arb_t res, const arb_t x, slong prec)
+{
+    if (arb_is_nonnegative(x))
+        arb_root_ui(res, x, 3, prec);
+    else if (arb_is_negative(x))
+    {
+        arb_neg(res, x);
+        arb_root_ui(res, res, 3, prec);
+        arb_neg(res, res);
+    }
+    else
+    {
+        arf_t u;
+        arb_t lo;
+
+        arf_init(u), arb_init(lo);
+        arb_get_lbound_arf(u, x, prec);
+        cbrt_arf(lo, u, prec);
+        arb_get_ubound_arf(u, x, prec);
+        cbrt_arf(res, u, prec);
+        arb_union(res, lo, res, prec);
+        arf_clear(u), arb_clear(lo);
+    }
+}
+
+void
+num_cbrt (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+
+    if (acb_is_real(_self -> dat))
+    {
+        num_cbrt_arb_(acb_realref(_res -> dat), acb_realref(_self -> dat), PREC);
+        arb_zero(acb_imagref(_res -> dat));
+    }
+    else
+        acb_root_ui(_res -> dat, _self -> dat, 3, PREC);
+}
+
+void
+num_rsqrt (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_rsqrt(_res -> dat, _self -> dat, PREC);
+}
+
+void
+num_sin_cos (num_t s, num_t c, const num_t self)
+{
+    struct num * _s = num_writable_(s);
+    struct num * _c = num_writable_(c);
+    const struct num * _self = self;
+    acb_sin_cos(_s -> dat, _c -> dat, _self -> dat, PREC);
+}
+
+void
+num_sinh_cosh (num_t s, num_t c, const num_t self)
+{
+    struct num * _s = num_writable_(s);
+    struct num * _c = num_writable_(c);
+    const struct num * _self = self;
+    acb_sinh_cosh(_s -> dat, _c -> dat, _self -> dat, PREC);
+}
+
+void
+num_exp_pi_i (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_exp_pi_i(_res -> dat, _self -> dat, PREC);
+}
+
+void
+num_sin_cos_pi (num_t s, num_t c, const num_t self)
+{
+    struct num * _s = num_writable_(s);
+    struct num * _c = num_writable_(c);
+    const struct num * _self = self;
+    acb_sin_cos_pi(_s -> dat, _c -> dat, _self -> dat, PREC);
+}
+
+void
+num_sin_cos_vec (num_t* s, num_t* c, const num_t* x, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_sin_cos(s[i], c[i], x[i]);
+}
+
+void
+num_sinh_cosh_vec (num_t* s, num_t* c, const num_t* x, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_sinh_cosh(s[i], c[i], x[i]);
+}
+
+void
+num_sin_cos_pi_vec (num_t* s, num_t* c, const num_t* x, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_sin_cos_pi(s[i], c[i], x[i]);
+}
+
+/* Midpoint-only kernels, used in NUM_MODE_MID */
+
+#define re_mid(x) arb_midref(acb_realref(x))
+#define im_mid(x) arb_midref(acb_imagref(x))
+
+static void
+mid_zero_rad (acb_t res)
+{
+    mag_zero(arb_radref(acb_realref(res)));
+    mag_zero(arb_radref(acb_imagref(res)));
+}
+
+static void
+mid_add (acb_t res, const acb_t x, const acb_t y)
+{
+    arf_add(re_mid(res), re_mid(x), re_mid(y), PREC, ARF_RND_NEAR);
+    arf_add(im_mid(res), im_mid(x), im_mid(y), PREC, ARF_RND_NEAR);
+    mid_zero_rad(res);
+}
+
+static void
+mid_sub (acb_t res, const acb_t x, const acb_t y)
+{
+    arf_sub(re_mid(res), re_mid(x), re_mid(y), PREC, ARF_RND_NEAR);
+    arf_sub(im_mid(res), im_mid(x), im_mid(y), PREC, ARF_RND_NEAR);
+    mid_zero_rad(res);
+}
+
+static void
+mid_mul (acb_t res, const acb_t x, const acb_t y)
+{
+    if (arf_is_zero(im_mid(x)) && arf_is_zero(im_mid(y)))
+    {
+        arf_mul(re_mid(res), re_mid(x), re_mid(y), PREC, ARF_RND_NEAR);
+        arf_zero(im_mid(res));
+    }
+    else
+    {
+        /* The product goes through temporaries, since res may alias x or y */
+        arf_t re, im;
+
+        arf_init(re), arf_init(im);
+        arf_complex_mul(re, im, re_mid(x), im_mid(x), re_mid(y), im_mid(y),
+                        PREC, ARF_RND_NEAR);
+        arf_swap(re_mid(res), re), arf_swap(im_mid(res), im);
+        arf_clear(re), arf_clear(im);
+    }
+    mid_zero_rad(res);
+}
+
+static void
+mid_div (acb_t res, const acb_t x, const acb_t y)
+{
+    if (arf_is_zero(im_mid(x)) && arf_is_zero(im_mid(y)))
+    {
+        arf_div(re_mid(res), re_mid(x), re_mid(y), PREC, ARF_RND_NEAR);
+        arf_zero(im_mid(res));
+    }
+    else
+    {
+        /* x/y = x conj(y) / |y|^2 */
+        arf_t re, im, den, yi;
+
+        arf_init(re), arf_init(im), arf_init(den), arf_init(yi);
+        arf_neg(yi, im_mid(y));
+        arf_sosq(den, re_mid(y), im_mid(y), 2 * PREC, ARF_RND_NEAR);
+        arf_complex_mul(re, im, re_mid(x), im_mid(x), re_mid(y), yi,
+                        2 * PREC, ARF_RND_NEAR);
+        arf_div(re_mid(res), re, den, PREC, ARF_RND_NEAR);
+        arf_div(im_mid(res), im, den, PREC, ARF_RND_NEAR);
+        arf_clear(re), arf_clear(im), arf_clear(den), arf_clear(yi);
+    }
+    mid_zero_rad(res);
+}
+
 /* Binary operations */
 
 /* Arithmetic */
@@ -391,17 +1029,49 @@ num_add (num_t res, const num_t self, const num_t other)
     struct num * _res = res;
     const struct num * _self = self;
     const struct num * _other = other;
-    acb_add(_res -> dat, _self -> dat, _other -> dat, PREC);
+
+    /* Exact, hence the same in both modes */
+    if (small_pair(_self, _other, SI_ADD_MAX))
+    {
+        set_small(_res, _self -> si + _other -> si);
+        return;
+    }
+
+    _res -> tag = NUM_TAG_ACB;
+    if (num_thread_mode == NUM_MODE_MID)
+        mid_add(_res -> dat, _self -> dat, _other -> dat);
+    else
+        acb_add(_res -> dat, _self -> dat, _other -> dat, PREC);
 }
 
 void
 num_add_d (num_t res, const num_t self, const double other)
 {
-    num_t o;
-    o = new(num);
-    num_set_d(o, other);
-    num_add(res, self, o);
-    delete(o);
+    struct num o;
+
+    scalar_d(&o, other);
+    num_add(res, self, &o);
+    scalar_clear(&o);
+}
+
+void
+num_add_si (num_t res, const num_t self, const long other)
+{
+    struct num o;
+
+    scalar_si(&o, other);
+    num_add(res, self, &o);
+    scalar_clear(&o);
+}
+
+void
+num_add_c (num_t res, const num_t self, const double complex other)
+{
+    struct num o;
+
+    scalar_c(&o, other);
+    num_add(res, self, &o);
+    scalar_clear(&o);
 }
 
 
@@ -411,7 +1081,49 @@ num_sub (num_t res, const num_t self, const num_t other)
     struct num * _res = res;
     const struct num * _self = self;
     const struct num * _other = other;
-    acb_sub(_res -> dat, _self -> dat, _other -> dat, PREC);
+
+    /* Exact, hence the same in both modes */
+    if (small_pair(_self, _other, SI_ADD_MAX))
+    {
+        set_small(_res, _self -> si - _other -> si);
+        return;
+    }
+
+    _res -> tag = NUM_TAG_ACB;
+    if (num_thread_mode == NUM_MODE_MID)
+        mid_sub(_res -> dat, _self -> dat, _other -> dat);
+    else
+        acb_sub(_res -> dat, _self -> dat, _other -> dat, PREC);
+}
+
+void
+num_sub_d (num_t res, const num_t self, const double other)
+{
+    struct num o;
+
+    scalar_d(&o, other);
+    num_sub(res, self, &o);
+    scalar_clear(&o);
+}
+
+void
+num_sub_si (num_t res, const num_t self, const long other)
+{
+    struct num o;
+
+    scalar_si(&o, other);
+    num_sub(res, self, &o);
+    scalar_clear(&o);
+}
+
+void
+num_sub_c (num_t res, const num_t self, const double complex other)
+{
+    struct num o;
+
+    scalar_c(&o, other);
+    num_sub(res, self, &o);
+    scalar_clear(&o);
 }
 
 void
@@ -420,33 +1132,160 @@ num_mul (num_t res, const num_t self, const num_t other)
     struct num * _res = res;
     const struct num * _self = self;
     const struct num * _other = other;
-    acb_mul(_res -> dat, _self -> dat, _other -> dat, PREC);    
+
+    /* Exact, hence the same in both modes */
+    if (small_pair(_self, _other, SI_MUL_MAX))
+    {
+        set_small(_res, _self -> si * _other -> si);
+        return;
+    }
+
+    _res -> tag = NUM_TAG_ACB;
+    if (num_thread_mode == NUM_MODE_MID)
+        mid_mul(_res -> dat, _self -> dat, _other -> dat);
+    else
+        acb_mul(_res -> dat, _self -> dat, _other -> dat, PREC);    
 }
 void
 num_mul_d (num_t res, const num_t self, const double other)
 {
-    num_t o;
-    o = new(num);
-    num_set_d(o, other);
-    num_mul(res, self, o);
-    delete(o);
+    struct num o;
+
+    scalar_d(&o, other);
+    num_mul(res, self, &o);
+    scalar_clear(&o);
 }
 
+void
+num_mul_c (num_t res, const num_t self, const double complex other)
+{
+    struct num o;
+
+    scalar_c(&o, other);
+    num_mul(res, self, &o);
+    scalar_clear(&o);
+}
 
 void
-num_div (num_t res, const num_t self, const num_t other)
+num_mul_si (num_t res, const num_t self, const long other)
 {
     struct num * _res = res;
     const struct num * _self = self;
+
+    if (_self -> tag == NUM_TAG_SI && other >= -SI_MUL_MAX && other <= SI_MUL_MAX
+        && _self -> si >= -SI_MUL_MAX && _self -> si <= SI_MUL_MAX)
+    {
+        set_small(_res, _self -> si * other);
+        return;
+    }
+
+    _res -> tag = NUM_TAG_ACB;
+    acb_mul_si(_res -> dat, _self -> dat, other, PREC);
+}
+
+void
+num_mul_2exp (num_t res, const num_t self, const long e)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_mul_2exp_si(_res -> dat, _self -> dat, e);
+}
+
+
+void
+num_div (num_t res, const num_t self, const num_t other)
+{
+    const struct num * _self = self;
     const struct num * _other = other;
-    acb_div(_res -> dat, _self -> dat, _other -> dat, PREC);
+    check_divisor(_other);
+
+    /* Exact quotients of small integers, hence the same in both modes */
+    if (small_pair(_self, _other, SI_ADD_MAX) && _other -> si != 0
+        && _self -> si % _other -> si == 0)
+    {
+        set_small(res, _self -> si / _other -> si);
+        return;
+    }
+
+    struct num * _res = num_writable_(res);
+    if (num_thread_mode == NUM_MODE_MID)
+        mid_div(_res -> dat, _self -> dat, _other -> dat);
+    else
+        acb_div(_res -> dat, _self -> dat, _other -> dat, PREC);
 }
 
 void
-num_fmod (num_t res, const num_t self, const num_t other)
+num_div_d (num_t res, const num_t self, const double other)
+{
+    struct num o;
+
+    scalar_d(&o, other);
+    num_div(res, self, &o);
+    scalar_clear(&o);
+}
+
+void
+num_div_si (num_t res, const num_t self, const long other)
+{
+    struct num o;
+
+    scalar_si(&o, other);
+    num_div(res, self, &o);
+    scalar_clear(&o);
+}
+
+void
+num_div_c (num_t res, const num_t self, const double complex other)
+{
+    struct num o;
+
+    scalar_c(&o, other);
+    num_div(res, self, &o);
+    scalar_clear(&o);
+}
+
+void
+num_d_div (num_t res, const double x, const num_t y)
+{
+    struct num o;
+
+    scalar_d(&o, x);
+    num_div(res, &o, y);
+    scalar_clear(&o);
+}
+
+void
+num_si_div (num_t res, const long x, const num_t y)
 {
-    assert(num_is_real(self) && num_is_real(other));
+    struct num o;
 
+    scalar_si(&o, x);
+    num_div(res, &o, y);
+    scalar_clear(&o);
+}
+
+void
+num_c_div (num_t res, const double complex x, const num_t y)
+{
+    struct num o;
+
+    scalar_c(&o, x);
+    num_div(res, &o, y);
+    scalar_clear(&o);
+}
+
+void
+num_div_ui (num_t res, const num_t self, const unsigned long other)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    if (other == 0) num_thread_flags |= NUM_FLAG_DIVBYZERO;
+    acb_div_ui(_res -> dat, _self -> dat, other, PREC);
+}
+
+void
+num_fmod (num_t res, const num_t self, const num_t other)
+{
     const double _self = num_to_d(self);
     const double _other = num_to_d(other);
     
@@ -456,19 +1295,50 @@ num_fmod (num_t res, const num_t self, const num_t other)
 void
 num_pow (num_t res, const num_t self, const num_t other)
 {
-    struct num * _res = res;
     const struct num * _self = self;
     const struct num * _other = other;
-    acb_pow(_res -> dat, _self -> dat, _other -> dat, PREC);
+    slong k;
+
+    /* Small powers of small integers are exact */
+    if (_self -> tag == NUM_TAG_SI && _other -> tag == NUM_TAG_SI && _other -> si >= 0
+        && si_pow(&k, _self -> si, _other -> si))
+    {
+        set_small(res, k);
+        return;
+    }
+
+    struct num * _res = num_writable_(res);
+    if (acb_is_real(_other -> dat))
+        pow_arb_acb(_res -> dat, _self -> dat, acb_realref(_other -> dat));
+    else
+        acb_pow(_res -> dat, _self -> dat, _other -> dat, PREC);
 }
 void
 num_pow_d (num_t res, const num_t self, const double other)
 {
-    num_t o;
-    o = new(num);
-    num_set_d(o, other);
-    num_pow(res, self, o);
-    delete(o);
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+
+    /* Integer exponents (exactly representable in a long) skip acb_pow */
+    if (other == floor(other) && fabs(other) < POW_SI_MAX)
+    {
+        pow_si_acb(_res -> dat, _self -> dat, (slong) other);
+        return;
+    }
+
+    arb_t y;
+    arb_init(y);
+    arb_set_d(y, other);
+    pow_arb_acb(_res -> dat, _self -> dat, y);
+    arb_clear(y);
+}
+
+void
+num_pow_si (num_t res, const num_t self, const long other)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    pow_si_acb(_res -> dat, _self -> dat, other);
 }
 
 
@@ -482,6 +1352,9 @@ num_eq (const num_t self, const num_t other)
     const struct num * _self = self;
     const struct num * _other = other;
 
+    if (_self -> tag == NUM_TAG_SI && _other -> tag == NUM_TAG_SI)
+        return _self -> si == _other -> si;
+
     arb_t _self_re, _self_im;
     arb_t _other_re, _other_im;
     arb_init(_self_re), arb_init(_self_im);
@@ -501,13 +1374,12 @@ num_eq (const num_t self, const num_t other)
 bool
 num_eq_d (const num_t self, const double other)
 {
-    num_t _other;
+    struct num o;
     bool ret;
 
-    _other = new(num);
-    num_set_d(_other, other);
-    ret = num_eq(self, _other);
-    delete(_other);
+    scalar_d(&o, other);
+    ret = num_eq(self, &o);
+    scalar_clear(&o);
 
     return ret;
 }
@@ -517,13 +1389,15 @@ num_eq_d (const num_t self, const double other)
 bool
 num_lt (const num_t self, const num_t other)
 {
-    assert(num_is_real(self) && num_is_real(other));
-
     int is_lt;
     
     const struct num * _self = self;
     const struct num * _other = other;
 
+    if (_self -> tag == NUM_TAG_SI && _other -> tag == NUM_TAG_SI)
+        return _self -> si < _other -> si;
+
+    check_real(_self), check_real(_other);
     arb_t _self_re,_other_re;
     arb_init(_self_re), arb_init(_other_re);
     acb_get_real(_self_re, _self -> dat);
@@ -537,13 +1411,15 @@ num_lt (const num_t self, const num_t other)
 bool
 num_gt (const num_t self, const num_t other)
 {
-    assert(num_is_real(self) && num_is_real(other));
-
     int is_gt;
     
     const struct num * _self = self;
     const struct num * _other = other;
 
+    if (_self -> tag == NUM_TAG_SI && _other -> tag == NUM_TAG_SI)
+        return _self -> si > _other -> si;
+
+    check_real(_self), check_real(_other);
     arb_t _self_re,_other_re;
     arb_init(_self_re), arb_init(_other_re);
     acb_get_real(_self_re, _self -> dat);
@@ -557,13 +1433,12 @@ num_gt (const num_t self, const num_t other)
 bool
 num_gt_d (const num_t self, const double other)
 {
-    num_t _other;
+    struct num o;
     bool ret;
 
-    _other = new(num);
-    num_set_d(_other, other);
-    ret = num_gt(self, _other);
-    delete(_other);
+    scalar_d(&o, other);
+    ret = num_gt(self, &o);
+    scalar_clear(&o);
 
     return ret;
 }
@@ -571,13 +1446,15 @@ num_gt_d (const num_t self, const double other)
 bool
 num_le (const num_t self, const num_t other)
 {
-    assert(num_is_real(self) && num_is_real(other));
-
     int is_le;
     
     const struct num * _self = self;
     const struct num * _other = other;
 
+    if (_self -> tag == NUM_TAG_SI && _other -> tag == NUM_TAG_SI)
+        return _self -> si <= _other -> si;
+
+    check_real(_self), check_real(_other);
     arb_t _self_re,_other_re;
     arb_init(_self_re), arb_init(_other_re);
     acb_get_real(_self_re, _self -> dat);
@@ -591,13 +1468,12 @@ num_le (const num_t self, const num_t other)
 bool
 num_le_d (const num_t self, const double other)
 {
+    struct num o;
     bool ret;
-    num_t _other;
 
-    _other = new(num);
-    num_set_d(_other, other);
-    ret = num_le(self, _other);
-    delete(_other);
+    scalar_d(&o, other);
+    ret = num_le(self, &o);
+    scalar_clear(&o);
 
     return ret;
 }
@@ -605,13 +1481,15 @@ num_le_d (const num_t self, const double other)
 bool
 num_ge (const num_t self, const num_t other)
 {
-    assert(num_is_real(self) && num_is_real(other));
-
     int is_ge;
     
     const struct num * _self = self;
     const struct num * _other = other;
 
+    if (_self -> tag == NUM_TAG_SI && _other -> tag == NUM_TAG_SI)
+        return _self -> si >= _other -> si;
+
+    check_real(_self), check_real(_other);
     arb_t _self_re,_other_re;
     arb_init(_self_re), arb_init(_other_re);
     acb_get_real(_self_re, _self -> dat);
@@ -625,13 +1503,12 @@ num_ge (const num_t self, const num_t other)
 bool
 num_ge_d (const num_t self, const double other)
 {
+    struct num o;
     bool ret;
-    num_t _other;
 
-    _other = new(num);
-    num_set_d(_other, other);
-    ret = num_ge(self, _other);
-    delete(_other);
+    scalar_d(&o, other);
+    ret = num_ge(self, &o);
+    scalar_clear(&o);
 
     return ret;
 }
@@ -639,7 +1516,7 @@ num_ge_d (const num_t self, const double other)
 void
 num_erf (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
     acb_hypgeom_erf(_res -> dat, _self -> dat, PREC);    
 }
@@ -647,7 +1524,7 @@ num_erf (num_t res, const num_t self)
 void
 num_erfc (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
     acb_hypgeom_erfc(_res -> dat, _self -> dat, PREC);  
 }
@@ -655,16 +1532,204 @@ num_erfc (num_t res, const num_t self)
 void
 num_rgamma (num_t res, const num_t self)
 {
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const struct num * _self = self;
     acb_hypgeom_rgamma(_res -> dat, _self -> dat, PREC);    
 }
 
+void
+num_gamma (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_gamma(_res -> dat, _self -> dat, PREC);
+}
+
+void
+num_lgamma (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_lgamma(_res -> dat, _self -> dat, PREC);
+}
+
+void
+num_digamma (num_t res, const num_t self)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    acb_digamma(_res -> dat, _self -> dat, PREC);
+}
+
+void
+num_bessel_j (num_t res, const num_t nu, const num_t z)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _nu = nu;
+    const struct num * _z = z;
+    acb_hypgeom_bessel_j(_res -> dat, _nu -> dat, _z -> dat, PREC);
+}
+
+void
+num_bessel_y (num_t res, const num_t nu, const num_t z)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _nu = nu;
+    const struct num * _z = z;
+    acb_hypgeom_bessel_y(_res -> dat, _nu -> dat, _z -> dat, PREC);
+}
+
+void
+num_bessel_i (num_t res, const num_t nu, const num_t z)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _nu = nu;
+    const struct num * _z = z;
+    acb_hypgeom_bessel_i(_res -> dat, _nu -> dat, _z -> dat, PREC);
+}
+
+void
+num_bessel_k (num_t res, const num_t nu, const num_t z)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _nu = nu;
+    const struct num * _z = z;
+    acb_hypgeom_bessel_k(_res -> dat, _nu -> dat, _z -> dat, PREC);
+}
+
+void
+num_expint (num_t res, const num_t s, const num_t z)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _s = s;
+    const struct num * _z = z;
+    acb_hypgeom_expint(_res -> dat, _s -> dat, _z -> dat, PREC);
+}
+
+void
+num_incgamma (num_t res, const num_t s, const num_t z)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _s = s;
+    const struct num * _z = z;
+    acb_hypgeom_gamma_upper(_res -> dat, _s -> dat, _z -> dat, 0, PREC);
+}
+
+void
+num_hyp1f1 (num_t res, const num_t a, const num_t b, const num_t z)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _a = a;
+    const struct num * _b = b;
+    const struct num * _z = z;
+    acb_hypgeom_m(_res -> dat, _a -> dat, _b -> dat, _z -> dat, 0, PREC);
+}
+
+void
+num_hyp2f1 (num_t res, const num_t a, const num_t b, const num_t c, const num_t z)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _a = a;
+    const struct num * _b = b;
+    const struct num * _c = c;
+    const struct num * _z = z;
+    acb_hypgeom_2f1(_res -> dat, _a -> dat, _b -> dat, _c -> dat, _z -> dat, 0, PREC);
+}
+
+/* Special functions: vector form */
+
+void
+num_gamma_vec (num_t* res, const num_t* x, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_gamma(res[i], x[i]);
+}
+
+void
+num_lgamma_vec (num_t* res, const num_t* x, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_lgamma(res[i], x[i]);
+}
+
+void
+num_digamma_vec (num_t* res, const num_t* x, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_digamma(res[i], x[i]);
+}
+
+void
+num_bessel_j_vec (num_t* res, const num_t nu, const num_t* z, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_bessel_j(res[i], nu, z[i]);
+}
+
+void
+num_bessel_y_vec (num_t* res, const num_t nu, const num_t* z, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_bessel_y(res[i], nu, z[i]);
+}
+
+void
+num_bessel_i_vec (num_t* res, const num_t nu, const num_t* z, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_bessel_i(res[i], nu, z[i]);
+}
+
+void
+num_bessel_k_vec (num_t* res, const num_t nu, const num_t* z, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_bessel_k(res[i], nu, z[i]);
+}
+
+void
+num_expint_vec (num_t* res, const num_t s, const num_t* z, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_expint(res[i], s, z[i]);
+}
+
+void
+num_incgamma_vec (num_t* res, const num_t s, const num_t* z, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_incgamma(res[i], s, z[i]);
+}
+
+void
+num_hyp1f1_vec (num_t* res, const num_t a, const num_t b, const num_t* z, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_hyp1f1(res[i], a, b, z[i]);
+}
+
+void
+num_hyp2f1_vec (num_t* res, const num_t a, const num_t b, const num_t c, const num_t* z, const size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        num_hyp2f1(res[i], a, b, c, z[i]);
+}
+
 void
 num_max (num_t res, const num_t self, const num_t other)
 {
-    assert(num_is_real(self) && num_is_real(other));
-    struct num * _res = res;
+    struct num * _res = num_writable_(res);
     const double _self = num_to_d(self);
     const double _other = num_to_d(other);
     acb_set_d(_res -> dat, (_self > _other) ? _self : _other );
@@ -676,3 +1741,21 @@ num_max3 (num_t res, const num_t self, const num_t other, const num_t another)
     num_max(res, self, other);
     num_max(res, res, another);
 }
+
+void
+num_union (num_t res, const num_t self, const num_t other)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    const struct num * _other = other;
+    acb_union(_res -> dat, _self -> dat, _other -> dat, PREC);
+}
+
+/* Memory */
+
+size_t
+num_memory_usage (const num_t self)
+{
+    const struct num * _self = self;
+    return size_of(self) + acb_allocated_bytes(_self -> dat);
+}
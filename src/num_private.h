@@ -0,0 +1,50 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file num_private.h
+ * @brief Representation of the num class.
+ * @details Shared by the modules which work on the Arb payload directly.
+ * The layout itself lives in num_inline.h, which exposes it to the inline
+ * functions.
+ */
+#ifndef __NUM_PRIVATE_H__
+#define __NUM_PRIVATE_H__
+
+#include "num_inline.h"
+
+/* Working precision, in bits */
+#define PREC NUM_PREC
+#define UNUSED(x) (void)(x)
+
+/* Raises the sticky exception flags of the thread, see num_test_flags() */
+void
+num_raise_flags_ (const int flags);
+
+/* Midpoint of x as a double, raising NUM_FLAG_NAN or NUM_FLAG_PRECISION */
+double
+num_arbtod_checked_ (const arb_t x);
+
+/* Sets res to the real number in str, in the syntax of num_set_str() */
+bool
+num_arb_set_str_ (arb_t res, const char* str);
+
+/* Real cube root, of either sign, shared by num_cbrt() and numr_cbrt() */
+void
+num_cbrt_arb_ (arb_t res, const arb_t x, slong prec);
+
+#endif /* __NUM_PRIVATE_H__ */
@@ -0,0 +1,328 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numpipe.c
+ * @brief Implementation of the streaming pipelines.
+ * @details Step k pops buffer numbers from queue k and pushes them to queue
+ * k + 1; the sink, last, pushes them back to queue 0, where the source
+ * finds the free buffers. Every queue can hold all the buffers plus the end
+ * marker, so a push never blocks.
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "abc.h"
+#include "new.h"
+#include "num.h"
+#include "numpipe.h"
+
+/* Marks the end of the stream in the queues */
+#define END ((size_t) -1)
+
+struct queue
+{
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    size_t * items;
+    size_t cap, head, count;
+};
+
+struct stage
+{
+    numpipe_stage_t f;
+    void * ctx;
+};
+
+struct numpipe
+{
+    const void * class; /* must be first */
+    size_t chunk, nbuffers;
+    num_t ** buffers;
+    size_t * lens;
+    struct stage * stages;
+    size_t nstages;
+    /* nstages + 2 entries, from the source to the sink */
+    struct numpipe_stats * stats;
+    struct queue * queues;
+    numpipe_source_t source;
+    void * source_ctx;
+    numpipe_sink_t sink;
+    void * sink_ctx;
+};
+
+static void *
+numpipe_ctor (void * self, va_list * app)
+{
+    struct numpipe * _self = self;
+    size_t i;
+
+    _self -> chunk = va_arg(* app, size_t);
+    _self -> nbuffers = va_arg(* app, size_t);
+    assert(_self -> chunk > 0 && _self -> nbuffers > 0);
+
+    _self -> buffers = malloc(_self -> nbuffers * sizeof(num_t *));
+    _self -> lens = malloc(_self -> nbuffers * sizeof(size_t));
+    _self -> stats = calloc(2, sizeof(struct numpipe_stats));
+    assert(_self -> buffers && _self -> lens && _self -> stats);
+    for (i = 0; i < _self -> nbuffers; i++)
+        _self -> buffers[i] = num_new_array(_self -> chunk);
+    _self -> stages = NULL, _self -> nstages = 0;
+
+    return _self;
+}
+
+static void *
+numpipe_dtor (void * self)
+{
+    struct numpipe * _self = self;
+    size_t i;
+
+    for (i = 0; i < _self -> nbuffers; i++)
+        num_delete_array(_self -> buffers[i], _self -> chunk);
+    free(_self -> buffers), free(_self -> lens);
+    free(_self -> stages), free(_self -> stats);
+    return self;
+}
+
+static const struct ABC _numpipe =
+{
+	sizeof(struct numpipe),
+	numpipe_ctor, numpipe_dtor
+};
+
+const void * numpipe = & _numpipe;
+
+static double
+now (void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+/**********/
+/* Queues */
+/**********/
+
+static void
+queue_init (struct queue * q, const size_t cap)
+{
+    pthread_mutex_init(&q -> lock, NULL);
+    pthread_cond_init(&q -> ready, NULL);
+    q -> items = malloc(cap * sizeof(size_t));
+    assert(q -> items);
+    q -> cap = cap, q -> head = 0, q -> count = 0;
+}
+
+static void
+queue_clear (struct queue * q)
+{
+    pthread_mutex_destroy(&q -> lock);
+    pthread_cond_destroy(&q -> ready);
+    free(q -> items);
+}
+
+static void
+queue_push (struct queue * q, const size_t item)
+{
+    pthread_mutex_lock(&q -> lock);
+    assert(q -> count < q -> cap);
+    q -> items[(q -> head + q -> count) % q -> cap] = item;
+    q -> count++;
+    pthread_cond_signal(&q -> ready);
+    pthread_mutex_unlock(&q -> lock);
+}
+
+static size_t
+queue_pop (struct queue * q)
+{
+    size_t item;
+
+    pthread_mutex_lock(&q -> lock);
+    while (q -> count == 0)
+        pthread_cond_wait(&q -> ready, &q -> lock);
+    item = q -> items[q -> head];
+    q -> head = (q -> head + 1) % q -> cap;
+    q -> count--;
+    pthread_mutex_unlock(&q -> lock);
+
+    return item;
+}
+
+/*********/
+/* Steps */
+/*********/
+
+struct step
+{
+    struct numpipe * p;
+    size_t k;
+};
+
+/* Runs the callback of step k on buffer b and accounts for it */
+static void
+step_call (struct numpipe * p, const size_t k, const size_t b)
+{
+    struct numpipe_stats * stats = &p -> stats[k];
+    const double t = now();
+
+    if (k == 0)
+        p -> lens[b] = p -> source(p -> buffers[b], p -> chunk, p -> source_ctx);
+    else if (k <= p -> nstages)
+        p -> stages[k - 1].f(p -> buffers[b], p -> lens[b], p -> stages[k - 1].ctx);
+    else
+        p -> sink((const num_t *) p -> buffers[b], p -> lens[b], p -> sink_ctx);
+
+    stats -> seconds += now() - t;
+    if (p -> lens[b] > 0)
+        stats -> chunks++, stats -> values += p -> lens[b];
+}
+
+static void *
+step_run (void * arg)
+{
+    const struct step * s = arg;
+    struct numpipe * p = s -> p;
+    const size_t k = s -> k, last = p -> nstages + 1;
+    size_t b;
+
+    num_thread_init();
+    for (;;)
+    {
+        b = queue_pop(&p -> queues[k]);
+        if (b == END) break;
+
+        step_call(p, k, b);
+        if (k == 0 && p -> lens[b] == 0)
+        {
+            /* The source is exhausted: the buffer is not needed anymore */
+            queue_push(&p -> queues[1], END);
+            break;
+        }
+        queue_push(&p -> queues[(k + 1) % (last + 1)], b);
+    }
+    if (k > 0 && k < last) queue_push(&p -> queues[k + 1], END);
+    /* The sink runs on the calling thread, whose caches are left alone */
+    if (k < last) num_thread_cleanup();
+
+    return NULL;
+}
+
+/****************************/
+/* User interface functions */
+/****************************/
+
+void
+numpipe_add_stage (numpipe_t self, numpipe_stage_t stage, void * ctx)
+{
+    struct numpipe * _self = self;
+
+    _self -> stages = realloc(_self -> stages, (_self -> nstages + 1) * sizeof(struct stage));
+    _self -> stats = realloc(_self -> stats, (_self -> nstages + 3) * sizeof(struct numpipe_stats));
+    assert(_self -> stages && _self -> stats);
+    _self -> stages[_self -> nstages].f = stage;
+    _self -> stages[_self -> nstages].ctx = ctx;
+    memset(&_self -> stats[_self -> nstages + 2], 0, sizeof(struct numpipe_stats));
+    _self -> nstages++;
+}
+
+size_t
+numpipe_nstages (const numpipe_t self)
+{
+    const struct numpipe * _self = self;
+    return _self -> nstages;
+}
+
+size_t
+numpipe_run (numpipe_t self, numpipe_source_t source, void * source_ctx,
+             numpipe_sink_t sink, void * sink_ctx)
+{
+    struct numpipe * _self = self;
+    const size_t nsteps = _self -> nstages + 2;
+    pthread_t * threads;
+    struct step * steps;
+    size_t k;
+
+    _self -> source = source, _self -> source_ctx = source_ctx;
+    _self -> sink = sink, _self -> sink_ctx = sink_ctx;
+    for (k = 0; k < nsteps; k++)
+        _self -> stats[k].chunks = 0, _self -> stats[k].values = 0, _self -> stats[k].seconds = 0.0;
+
+    _self -> queues = malloc(nsteps * sizeof(struct queue));
+    threads = malloc(nsteps * sizeof(pthread_t));
+    steps = malloc(nsteps * sizeof(struct step));
+    assert(_self -> queues && threads && steps);
+    for (k = 0; k < nsteps; k++)
+    {
+        queue_init(&_self -> queues[k], _self -> nbuffers + 1);
+        steps[k].p = _self, steps[k].k = k;
+    }
+    for (k = 0; k < _self -> nbuffers; k++)
+        queue_push(&_self -> queues[0], k);
+
+    /* The calling thread is the sink */
+    for (k = 0; k + 1 < nsteps; k++)
+        pthread_create(&threads[k], NULL, step_run, &steps[k]);
+    step_run(&steps[nsteps - 1]);
+    for (k = 0; k + 1 < nsteps; k++)
+        pthread_join(threads[k], NULL);
+
+    for (k = 0; k < nsteps; k++)
+        queue_clear(&_self -> queues[k]);
+    free(_self -> queues), free(threads), free(steps);
+
+    return _self -> stats[nsteps - 1].values;
+}
+
+void
+numpipe_stats (const numpipe_t self, const size_t k, struct numpipe_stats* stats)
+{
+    const struct numpipe * _self = self;
+
+    assert(k < _self -> nstages + 2);
+    * stats = _self -> stats[k];
+}
+
+void
+numpipe_print_stats (const numpipe_t self)
+{
+    const struct numpipe * _self = self;
+    const struct numpipe_stats * s;
+    size_t k;
+
+    for (k = 0; k < _self -> nstages + 2; k++)
+    {
+        s = &_self -> stats[k];
+        if (k == 0)
+            printf("source  ");
+        else if (k <= _self -> nstages)
+            printf("stage %zu ", k);
+        else
+            printf("sink    ");
+        printf("%zu values in %zu chunks, %.3g values/s\n", s -> values, s -> chunks,
+               (s -> seconds > 0.0) ? s -> values / s -> seconds : 0.0);
+    }
+}
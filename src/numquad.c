@@ -0,0 +1,327 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numquad.c
+ * @brief Implementation of the numerical integration routines.
+ */
+#include <assert.h>
+#include <complex.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "new.h"
+#include "num.h"
+#include "num_private.h"
+#include "numquad.h"
+#include "parallel.h"
+
+#include <arb.h>
+#include <acb.h>
+#include <arb_hypgeom.h>
+#include <acb_calc.h>
+
+/************************/
+/* Gauss-Legendre nodes */
+/************************/
+
+struct gl_rule
+{
+    int n;
+    double * t; /* nodes in [-1, 1] */
+    double * w; /* weights */
+    struct gl_rule * next;
+};
+
+static struct gl_rule * gl_cache = NULL;
+static pthread_mutex_t gl_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static const struct gl_rule *
+gl_rule (const int n)
+{
+    struct gl_rule * rule;
+    arb_t t, w;
+    int k;
+
+    pthread_mutex_lock(&gl_lock);
+    for (rule = gl_cache; rule; rule = rule -> next)
+        if (rule -> n == n) break;
+
+    if (!rule)
+    {
+        rule = malloc(sizeof(struct gl_rule));
+        assert(rule);
+        rule -> n = n;
+        rule -> t = malloc(n * sizeof(double));
+        rule -> w = malloc(n * sizeof(double));
+        assert(rule -> t && rule -> w);
+
+        arb_init(t), arb_init(w);
+        for (k = 0; k < n; k++)
+        {
+            arb_hypgeom_legendre_p_ui_root(t, w, n, k, 2 * PREC);
+            rule -> t[k] = arf_get_d(arb_midref(t), ARF_RND_NEAR);
+            rule -> w[k] = arf_get_d(arb_midref(w), ARF_RND_NEAR);
+        }
+        arb_clear(t), arb_clear(w);
+
+        rule -> next = gl_cache;
+        gl_cache = rule;
+    }
+    pthread_mutex_unlock(&gl_lock);
+
+    return rule;
+}
+
+struct gl_batch
+{
+    num_func_t f;
+    void * ctx;
+    num_t * x;
+    num_t * y;
+};
+
+static void
+gl_eval (size_t begin, size_t end, void * arg)
+{
+    struct gl_batch * batch = arg;
+    size_t i;
+
+    for (i = begin; i < end; i++)
+        batch -> f(batch -> y[i], batch -> x[i], batch -> ctx);
+}
+
+void
+num_quad_gl (num_t res, num_func_t f, void * ctx,
+             const num_t a, const num_t b, const int n, const int nthreads)
+{
+    const struct gl_rule * rule;
+    struct gl_batch batch;
+    num_t mid, half, acc;
+    int i;
+
+    assert(n > 0);
+    rule = gl_rule(n);
+
+    mid = new(num), half = new(num), acc = new(num);
+    num_add(mid, a, b);
+    num_mul_2exp(mid, mid, -1);
+    num_sub(half, b, a);
+    num_mul_2exp(half, half, -1);
+
+    batch.f = f, batch.ctx = ctx;
+    batch.x = malloc(n * sizeof(num_t));
+    batch.y = malloc(n * sizeof(num_t));
+    assert(batch.x && batch.y);
+    for (i = 0; i < n; i++)
+    {
+        batch.x[i] = new(num), batch.y[i] = new(num);
+        num_mul_d(batch.x[i], half, rule -> t[i]);
+        num_add(batch.x[i], batch.x[i], mid);
+    }
+
+    parallel_for(n, nthreads, gl_eval, &batch);
+
+    /* Summed in a fixed order, whatever the number of threads */
+    num_zero(acc);
+    for (i = 0; i < n; i++)
+    {
+        num_mul_d(batch.y[i], batch.y[i], rule -> w[i]);
+        num_add(acc, acc, batch.y[i]);
+        delete(batch.x[i]), delete(batch.y[i]);
+    }
+    num_mul(res, acc, half);
+
+    free(batch.x), free(batch.y);
+    delete(mid), delete(half), delete(acc);
+}
+
+/*************************/
+/* Gauss-Kronrod (G7K15) */
+/*************************/
+
+/* Kronrod nodes; the odd ones are the Gauss nodes */
+static const double xgk[8] =
+{
+    0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245, 0.000000000000000000000000000000000
+};
+
+static const double wgk[8] =
+{
+    0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+};
+
+static const double wg[4] =
+{
+    0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975, 0.417959183673469387755102040816327
+};
+
+struct gk_interval
+{
+    double a, b;
+    double complex val;
+    double err;
+};
+
+static double complex
+gk_eval (num_func_t f, void * ctx, num_t x, num_t y, const double t)
+{
+    num_set_d(x, t);
+    f(y, x, ctx);
+
+    return num_to_complex(y);
+}
+
+static void
+gk15 (struct gk_interval * iv, num_func_t f, void * ctx, num_t x, num_t y)
+{
+    const double c = 0.5 * (iv -> a + iv -> b);
+    const double h = 0.5 * (iv -> b - iv -> a);
+    double complex fx[15];
+    double complex resk, resg;
+    int j;
+
+    /* Evaluated one after the other, in the calling thread */
+    for (j = 0; j < 7; j++)
+    {
+        fx[2 * j] = gk_eval(f, ctx, x, y, c - h * xgk[j]);
+        fx[2 * j + 1] = gk_eval(f, ctx, x, y, c + h * xgk[j]);
+    }
+    fx[14] = gk_eval(f, ctx, x, y, c);
+
+    resk = wgk[7] * fx[14];
+    resg = wg[3] * fx[14];
+    for (j = 0; j < 7; j++)
+    {
+        const double complex s = fx[2 * j] + fx[2 * j + 1];
+
+        resk += wgk[j] * s;
+        if (j % 2 == 1) resg += wg[j / 2] * s;
+    }
+
+    iv -> val = h * resk;
+    iv -> err = fabs(h) * cabs(resk - resg);
+}
+
+int
+num_quad_gk (num_t res, num_func_t f, void * ctx,
+             const num_t a, const num_t b,
+             const double abstol, const double reltol, const int maxeval)
+{
+    /* A rule takes 15 evaluations, and each bisection two rules */
+    const size_t cap = (maxeval > 15) ? 1 + (size_t) (maxeval - 15) / 30 : 1;
+    struct gk_interval * iv = malloc(cap * sizeof(struct gk_interval));
+    double complex total;
+    double err;
+    size_t m = 1, i, worst;
+    long evals = 15;
+    int status = NUM_QUAD_MAXEVAL;
+    num_t x, y;
+
+    assert(iv);
+    x = new(num), y = new(num);
+    iv[0].a = num_real_d(a), iv[0].b = num_real_d(b);
+    gk15(&iv[0], f, ctx, x, y);
+
+    for (;;)
+    {
+        total = 0.0, err = 0.0, worst = 0;
+        for (i = 0; i < m; i++)
+        {
+            total += iv[i].val, err += iv[i].err;
+            if (iv[i].err > iv[worst].err) worst = i;
+        }
+        if (err <= fmax(abstol, reltol * cabs(total)))
+        {
+            status = NUM_QUAD_OK;
+            break;
+        }
+        if (evals + 30 > maxeval) break;
+
+        /* Bisect the interval with the largest error */
+        iv[m].a = 0.5 * (iv[worst].a + iv[worst].b);
+        iv[m].b = iv[worst].b;
+        iv[worst].b = iv[m].a;
+        gk15(&iv[worst], f, ctx, x, y);
+        gk15(&iv[m], f, ctx, x, y);
+        evals += 30, m++;
+    }
+    num_set_d_d(res, creal(total), cimag(total));
+
+    free(iv);
+    delete(x), delete(y);
+    return status;
+}
+
+/**************************************/
+/* Rigorous integration with acb_calc */
+/**************************************/
+
+struct calc_param
+{
+    num_func_t f;
+    void * ctx;
+    struct num * x;
+    struct num * y;
+};
+
+static int
+calc_func (acb_ptr out, const acb_t inp, void * param, slong order, slong prec)
+{
+    UNUSED(order), UNUSED(prec);
+    struct calc_param * p = param;
+
+    acb_set(p -> x -> dat, inp);
+    p -> f(p -> y, p -> x, p -> ctx);
+    acb_set(out, p -> y -> dat);
+
+    return 0;
+}
+
+int
+num_quad_rigorous (num_t res, num_func_t f, void * ctx,
+                   const num_t a, const num_t b, const double abstol)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _a = a;
+    const struct num * _b = b;
+    struct calc_param param;
+    acb_calc_integrate_opt_t options;
+    mag_t tol;
+    int status;
+
+    param.f = f, param.ctx = ctx;
+    param.x = new(num), param.y = new(num);
+    acb_calc_integrate_opt_init(options);
+    mag_init(tol);
+    mag_set_d(tol, abstol);
+
+    status = acb_calc_integrate(_res -> dat, calc_func, &param,
+                                _a -> dat, _b -> dat, PREC, tol, options, PREC);
+
+    mag_clear(tol);
+    delete(param.x), delete(param.y);
+    return (status == ACB_CALC_SUCCESS) ? NUM_QUAD_OK : NUM_QUAD_MAXEVAL;
+}
@@ -0,0 +1,860 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numr.c
+ * @brief Implementation of the real numbers.
+ * @details The functions are the arb_* counterparts of those of num.c, at
+ * the working precision.
+ */
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "abc.h"
+#include "new.h"
+#include "num.h"
+#include "numr.h"
+#include "num_private.h"
+
+#include <arb.h>
+#include <arb_hypgeom.h>
+#include <acb.h>
+
+struct numr
+{
+    const void * class; /* must be first */
+    arb_t dat;
+};
+
+static void *
+numr_ctor (void * self, va_list * app)
+{
+    UNUSED(app);
+    struct numr * _self = self;
+    arb_init(_self -> dat);
+    return _self;
+}
+
+static void *
+numr_dtor (void * self)
+{
+    struct numr * _self = self;
+    arb_clear(_self -> dat);
+    return self;
+}
+
+static const struct ABC _numr =
+{
+	sizeof(struct numr),
+	numr_ctor, numr_dtor
+};
+
+const void * numr = & _numr;
+
+/* Signature of the real functions of Arb, e.g. arb_exp() */
+typedef void (* real_func_t) (arb_t res, const arb_t x, slong prec);
+
+static void
+unary (numr_t res, const numr_t self, real_func_t f)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    f(_res -> dat, _self -> dat, PREC);
+}
+
+/* Signature of the real functions of two arguments, e.g. arb_hypgeom_expint() */
+typedef void (* real_func2_t) (arb_t res, const arb_t x, const arb_t y, slong prec);
+
+static void
+binary (numr_t res, const numr_t x, const numr_t y, real_func2_t f)
+{
+    struct numr * _res = res;
+    const struct numr * _x = x;
+    const struct numr * _y = y;
+    f(_res -> dat, _x -> dat, _y -> dat, PREC);
+}
+
+/* Raises NUM_FLAG_DIVBYZERO if x is exactly zero, as num_div() */
+static void
+check_divisor (const arb_t x)
+{
+    if (arb_is_zero(x)) num_raise_flags_(NUM_FLAG_DIVBYZERO);
+}
+
+static int
+cmp_d (const numr_t self, const double other, int (* cmp) (const arb_t x, const arb_t y))
+{
+    const struct numr * _self = self;
+    arb_t o;
+    int ret;
+
+    arb_init(o);
+    arb_set_d(o, other);
+    ret = cmp(_self -> dat, o);
+    arb_clear(o);
+
+    return ret;
+}
+
+/****************************/
+/* User interface functions */
+/****************************/
+
+/* Same layout as num_new_array(): the pointers, then the objects */
+numr_t *
+numr_new_array (const size_t n)
+{
+    numr_t * arr = calloc(n, sizeof(numr_t) + sizeof(struct numr));
+    struct numr * o;
+    size_t i;
+
+    if (arr == NULL) return NULL;
+    o = (struct numr *) (arr + n);
+    for (i = 0; i < n; i++)
+    {
+        o[i].class = numr;
+        arb_init(o[i].dat);
+        arr[i] = &o[i];
+    }
+    return arr;
+}
+
+void
+numr_delete_array (numr_t * arr, const size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        struct numr * o = arr[i];
+        arb_clear(o -> dat);
+    }
+    free(arr);
+}
+
+size_t
+numr_memory_usage (const numr_t self)
+{
+    const struct numr * _self = self;
+    return size_of(self) + arb_allocated_bytes(_self -> dat);
+}
+
+void
+numr_print (const numr_t self, const bool endline)
+{
+    const struct numr * _self = self;
+    const slong digits = 8;
+    const ulong flags = 0;
+
+    arb_printn(_self -> dat, digits, flags);
+    if (endline) puts("\n");
+}
+
+/* Interoperation */
+
+void
+numr_set_num (numr_t self, const num_t x)
+{
+    struct numr * _self = self;
+    const struct num * _x = x;
+
+    if (!num_is_real(x)) num_raise_flags_(NUM_FLAG_NONREAL);
+    arb_set(_self -> dat, acb_realref(_x -> dat));
+}
+
+void
+num_set_numr (num_t self, const numr_t x)
+{
+    struct num * _self = num_writable_(self);
+    const struct numr * _x = x;
+    acb_set_arb(_self -> dat, _x -> dat);
+}
+
+void
+num_add_numr (num_t res, const num_t self, const numr_t other)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    const struct numr * _other = other;
+    acb_add_arb(_res -> dat, _self -> dat, _other -> dat, PREC);
+}
+
+void
+num_sub_numr (num_t res, const num_t self, const numr_t other)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    const struct numr * _other = other;
+    acb_sub_arb(_res -> dat, _self -> dat, _other -> dat, PREC);
+}
+
+void
+num_mul_numr (num_t res, const num_t self, const numr_t other)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    const struct numr * _other = other;
+    acb_mul_arb(_res -> dat, _self -> dat, _other -> dat, PREC);
+}
+
+void
+num_div_numr (num_t res, const num_t self, const numr_t other)
+{
+    struct num * _res = num_writable_(res);
+    const struct num * _self = self;
+    const struct numr * _other = other;
+    acb_div_arb(_res -> dat, _self -> dat, _other -> dat, PREC);
+}
+
+/* Basic manipulation */
+
+void
+numr_zero (numr_t self)
+{
+    struct numr * _self = self;
+    arb_zero(_self -> dat);
+}
+
+void
+numr_one (numr_t self)
+{
+    struct numr * _self = self;
+    arb_one(_self -> dat);
+}
+
+void
+numr_set (numr_t self, const numr_t other)
+{
+    struct numr * _self = self;
+    const struct numr * _other = other;
+    arb_set(_self -> dat, _other -> dat);
+}
+
+void
+numr_set_d (numr_t self, const double x)
+{
+    struct numr * _self = self;
+    arb_set_d(_self -> dat, x);
+}
+
+void
+numr_set_si (numr_t self, const long x)
+{
+    struct numr * _self = self;
+    arb_set_si(_self -> dat, x);
+}
+
+void
+numr_set_ui (numr_t self, const unsigned long x)
+{
+    struct numr * _self = self;
+    arb_set_ui(_self -> dat, x);
+}
+
+void
+numr_set_fmpz (numr_t self, const fmpz_t x)
+{
+    struct numr * _self = self;
+    arb_set_fmpz(_self -> dat, x);
+}
+
+void
+numr_set_q (numr_t self, const fmpq_t x)
+{
+    struct numr * _self = self;
+    arb_set_fmpq(_self -> dat, x, PREC);
+}
+
+bool
+numr_set_str (numr_t self, const char* str)
+{
+    struct numr * _self = self;
+    return num_arb_set_str_(_self -> dat, str);
+}
+
+/* Predicates */
+
+bool
+numr_is_zero (const numr_t self)
+{
+    const struct numr * _self = self;
+    return arb_is_zero(_self -> dat) != 0;
+}
+
+bool
+numr_is_identical (const numr_t self, const numr_t other)
+{
+    const struct numr * _self = self;
+    const struct numr * _other = other;
+    return arb_equal(_self -> dat, _other -> dat) != 0;
+}
+
+/* Ball radius and casts */
+
+double
+numr_rad_d (const numr_t self)
+{
+    const struct numr * _self = self;
+    return mag_get_d(arb_radref(_self -> dat));
+}
+
+long
+numr_rel_accuracy_bits (const numr_t self)
+{
+    const struct numr * _self = self;
+    return arb_rel_accuracy_bits(_self -> dat);
+}
+
+void
+numr_mid (numr_t res, const numr_t self)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    arb_get_mid_arb(_res -> dat, _self -> dat);
+}
+
+double
+numr_to_d (const numr_t self)
+{
+    const struct numr * _self = self;
+    return num_arbtod_checked_(_self -> dat);
+}
+
+/* Unary operations */
+
+void
+numr_abs (numr_t res, const numr_t self)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    arb_abs(_res -> dat, _self -> dat);
+}
+
+void
+numr_neg (numr_t res, const numr_t self)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    arb_neg(_res -> dat, _self -> dat);
+}
+
+void
+numr_inv (numr_t res, const numr_t self)
+{
+    const struct numr * _self = self;
+    check_divisor(_self -> dat);
+    unary(res, self, arb_inv);
+}
+
+/* On the midpoint, as num_ceil() */
+void
+numr_ceil (numr_t res, const numr_t self)
+{
+    numr_set_d(res, ceil(numr_to_d(self)));
+}
+
+void
+numr_sqrt (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_sqrt);
+}
+
+void
+numr_rsqrt (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_rsqrt);
+}
+
+void
+numr_cbrt (numr_t res, const numr_t self)
+{
+    unary(res, self, num_cbrt_arb_);
+}
+
+void
+numr_exp (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_exp);
+}
+
+void
+numr_expm1 (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_expm1);
+}
+
+void
+numr_log (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_log);
+}
+
+void
+numr_log1p (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_log1p);
+}
+
+void
+numr_sin (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_sin);
+}
+
+void
+numr_cos (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_cos);
+}
+
+void
+numr_tan (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_tan);
+}
+
+void
+numr_sinh (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_sinh);
+}
+
+void
+numr_cosh (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_cosh);
+}
+
+void
+numr_atan (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_atan);
+}
+
+void
+numr_asin (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_asin);
+}
+
+void
+numr_acos (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_acos);
+}
+
+void
+numr_sin_cos (numr_t s, numr_t c, const numr_t self)
+{
+    struct numr * _s = s;
+    struct numr * _c = c;
+    const struct numr * _self = self;
+    arb_sin_cos(_s -> dat, _c -> dat, _self -> dat, PREC);
+}
+
+void
+numr_sin_cos_pi (numr_t s, numr_t c, const numr_t self)
+{
+    struct numr * _s = s;
+    struct numr * _c = c;
+    const struct numr * _self = self;
+    arb_sin_cos_pi(_s -> dat, _c -> dat, _self -> dat, PREC);
+}
+
+void
+numr_sinh_cosh (numr_t s, numr_t c, const numr_t self)
+{
+    struct numr * _s = s;
+    struct numr * _c = c;
+    const struct numr * _self = self;
+    arb_sinh_cosh(_s -> dat, _c -> dat, _self -> dat, PREC);
+}
+
+void
+numr_atan2 (numr_t res, const numr_t y, const numr_t x)
+{
+    binary(res, y, x, arb_atan2);
+}
+
+/* Binary operations */
+
+void
+numr_add (numr_t res, const numr_t self, const numr_t other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    const struct numr * _other = other;
+    arb_add(_res -> dat, _self -> dat, _other -> dat, PREC);
+}
+
+void
+numr_add_d (numr_t res, const numr_t self, const double other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    arb_t o;
+
+    arb_init(o);
+    arb_set_d(o, other);
+    arb_add(_res -> dat, _self -> dat, o, PREC);
+    arb_clear(o);
+}
+
+void
+numr_add_si (numr_t res, const numr_t self, const long other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    arb_add_si(_res -> dat, _self -> dat, other, PREC);
+}
+
+void
+numr_sub (numr_t res, const numr_t self, const numr_t other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    const struct numr * _other = other;
+    arb_sub(_res -> dat, _self -> dat, _other -> dat, PREC);
+}
+
+void
+numr_sub_d (numr_t res, const numr_t self, const double other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    arb_t o;
+
+    arb_init(o);
+    arb_set_d(o, other);
+    arb_sub(_res -> dat, _self -> dat, o, PREC);
+    arb_clear(o);
+}
+
+void
+numr_sub_si (numr_t res, const numr_t self, const long other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    arb_sub_si(_res -> dat, _self -> dat, other, PREC);
+}
+
+void
+numr_mul (numr_t res, const numr_t self, const numr_t other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    const struct numr * _other = other;
+    arb_mul(_res -> dat, _self -> dat, _other -> dat, PREC);
+}
+
+void
+numr_mul_d (numr_t res, const numr_t self, const double other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    arb_t o;
+
+    arb_init(o);
+    arb_set_d(o, other);
+    arb_mul(_res -> dat, _self -> dat, o, PREC);
+    arb_clear(o);
+}
+
+void
+numr_mul_si (numr_t res, const numr_t self, const long other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    arb_mul_si(_res -> dat, _self -> dat, other, PREC);
+}
+
+void
+numr_mul_2exp (numr_t res, const numr_t self, const long e)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    arb_mul_2exp_si(_res -> dat, _self -> dat, e);
+}
+
+void
+numr_div (numr_t res, const numr_t self, const numr_t other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    const struct numr * _other = other;
+    check_divisor(_other -> dat);
+    arb_div(_res -> dat, _self -> dat, _other -> dat, PREC);
+}
+
+void
+numr_div_d (numr_t res, const numr_t self, const double other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    arb_t o;
+
+    arb_init(o);
+    arb_set_d(o, other);
+    check_divisor(o);
+    arb_div(_res -> dat, _self -> dat, o, PREC);
+    arb_clear(o);
+}
+
+void
+numr_div_si (numr_t res, const numr_t self, const long other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    if (other == 0) num_raise_flags_(NUM_FLAG_DIVBYZERO);
+    arb_div_si(_res -> dat, _self -> dat, other, PREC);
+}
+
+void
+numr_div_ui (numr_t res, const numr_t self, const unsigned long other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    if (other == 0) num_raise_flags_(NUM_FLAG_DIVBYZERO);
+    arb_div_ui(_res -> dat, _self -> dat, other, PREC);
+}
+
+/* On the midpoints, as num_fmod() */
+void
+numr_fmod (numr_t res, const numr_t self, const numr_t other)
+{
+    numr_set_d(res, fmod(numr_to_d(self), numr_to_d(other)));
+}
+
+void
+numr_pow (numr_t res, const numr_t self, const numr_t other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    const struct numr * _other = other;
+    arb_pow(_res -> dat, _self -> dat, _other -> dat, PREC);
+}
+
+void
+numr_pow_d (numr_t res, const numr_t self, const double other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    arb_t o;
+
+    arb_init(o);
+    arb_set_d(o, other);
+    arb_pow(_res -> dat, _self -> dat, o, PREC);
+    arb_clear(o);
+}
+
+void
+numr_pow_si (numr_t res, const numr_t self, const long other)
+{
+    struct numr * _res = res;
+    const struct numr * _self = self;
+    fmpz_t e;
+
+    fmpz_init(e);
+    fmpz_set_si(e, other);
+    arb_pow_fmpz(_res -> dat, _self -> dat, e, PREC);
+    fmpz_clear(e);
+}
+
+/* Logical */
+
+bool
+numr_eq (const numr_t self, const numr_t other)
+{
+    const struct numr * _self = self;
+    const struct numr * _other = other;
+    return arb_eq(_self -> dat, _other -> dat) != 0;
+}
+
+bool
+numr_lt (const numr_t self, const numr_t other)
+{
+    const struct numr * _self = self;
+    const struct numr * _other = other;
+    return arb_lt(_self -> dat, _other -> dat) != 0;
+}
+
+bool
+numr_gt (const numr_t self, const numr_t other)
+{
+    const struct numr * _self = self;
+    const struct numr * _other = other;
+    return arb_gt(_self -> dat, _other -> dat) != 0;
+}
+
+bool
+numr_le (const numr_t self, const numr_t other)
+{
+    const struct numr * _self = self;
+    const struct numr * _other = other;
+    return arb_le(_self -> dat, _other -> dat) != 0;
+}
+
+bool
+numr_ge (const numr_t self, const numr_t other)
+{
+    const struct numr * _self = self;
+    const struct numr * _other = other;
+    return arb_ge(_self -> dat, _other -> dat) != 0;
+}
+
+bool
+numr_eq_d (const numr_t self, const double other)
+{
+    return cmp_d(self, other, arb_eq) != 0;
+}
+
+bool
+numr_gt_d (const numr_t self, const double other)
+{
+    return cmp_d(self, other, arb_gt) != 0;
+}
+
+bool
+numr_ge_d (const numr_t self, const double other)
+{
+    return cmp_d(self, other, arb_ge) != 0;
+}
+
+bool
+numr_le_d (const numr_t self, const double other)
+{
+    return cmp_d(self, other, arb_le) != 0;
+}
+
+/* Special functions */
+
+void
+numr_erf (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_hypgeom_erf);
+}
+
+void
+numr_erfc (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_hypgeom_erfc);
+}
+
+void
+numr_gamma (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_gamma);
+}
+
+void
+numr_rgamma (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_rgamma);
+}
+
+void
+numr_lgamma (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_lgamma);
+}
+
+void
+numr_digamma (numr_t res, const numr_t self)
+{
+    unary(res, self, arb_digamma);
+}
+
+void
+numr_bessel_j (numr_t res, const numr_t nu, const numr_t z)
+{
+    binary(res, nu, z, arb_hypgeom_bessel_j);
+}
+
+void
+numr_bessel_y (numr_t res, const numr_t nu, const numr_t z)
+{
+    binary(res, nu, z, arb_hypgeom_bessel_y);
+}
+
+void
+numr_bessel_i (numr_t res, const numr_t nu, const numr_t z)
+{
+    binary(res, nu, z, arb_hypgeom_bessel_i);
+}
+
+void
+numr_bessel_k (numr_t res, const numr_t nu, const numr_t z)
+{
+    binary(res, nu, z, arb_hypgeom_bessel_k);
+}
+
+void
+numr_expint (numr_t res, const numr_t s, const numr_t z)
+{
+    binary(res, s, z, arb_hypgeom_expint);
+}
+
+void
+numr_incgamma (numr_t res, const numr_t s, const numr_t z)
+{
+    struct numr * _res = res;
+    const struct numr * _s = s;
+    const struct numr * _z = z;
+    arb_hypgeom_gamma_upper(_res -> dat, _s -> dat, _z -> dat, 0, PREC);
+}
+
+void
+numr_hyp1f1 (numr_t res, const numr_t a, const numr_t b, const numr_t z)
+{
+    struct numr * _res = res;
+    const struct numr * _a = a;
+    const struct numr * _b = b;
+    const struct numr * _z = z;
+    arb_hypgeom_m(_res -> dat, _a -> dat, _b -> dat, _z -> dat, 0, PREC);
+}
+
+void
+numr_hyp2f1 (numr_t res, const numr_t a, const numr_t b, const numr_t c, const numr_t z)
+{
+    struct numr * _res = res;
+    const struct numr * _a = a;
+    const struct numr * _b = b;
+    const struct numr * _c = c;
+    const struct numr * _z = z;
+    arb_hypgeom_2f1(_res -> dat, _a -> dat, _b -> dat, _c -> dat, _z -> dat, 0, PREC);
+}
+
+void
+numr_max (numr_t res, const numr_t self, const numr_t other)
+{
+    binary(res, self, other, arb_max);
+}
+
+void
+numr_max3 (numr_t res, const numr_t self, const numr_t other, const numr_t another)
+{
+    numr_max(res, self, other);
+    numr_max(res, res, another);
+}
+
+void
+numr_union (numr_t res, const numr_t self, const numr_t other)
+{
+    binary(res, self, other, arb_union);
+}
@@ -0,0 +1,321 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numser.c
+ * @brief Implementation of the truncated power series.
+ * @details The series are acb_poly_t, and the functions are the series
+ * versions of Arb, e.g. acb_poly_exp_series(), at the working precision.
+ */
+#include <assert.h>
+#include <stdarg.h>
+
+#include "abc.h"
+#include "new.h"
+#include "num.h"
+#include "numser.h"
+#include "num_private.h"
+
+#include <acb_poly.h>
+#include <acb_hypgeom.h>
+
+struct numser
+{
+    const void * class; /* must be first */
+    acb_poly_t dat;
+    slong len;
+};
+
+static void *
+numser_ctor (void * self, va_list * app)
+{
+    struct numser * _self = self;
+
+    _self -> len = va_arg(* app, int);
+    assert(_self -> len >= 1);
+    acb_poly_init(_self -> dat);
+
+    return _self;
+}
+
+static void *
+numser_dtor (void * self)
+{
+    struct numser * _self = self;
+    acb_poly_clear(_self -> dat);
+    return self;
+}
+
+static const struct ABC _numser =
+{
+	sizeof(struct numser),
+	numser_ctor, numser_dtor
+};
+
+const void * numser = & _numser;
+
+/* Signature of the series functions of Arb, e.g. acb_poly_exp_series() */
+typedef void (* series_func_t) (acb_poly_t res, const acb_poly_t f, slong n, slong prec);
+
+/* Applies f through a temporary, so that res may alias self. */
+static void
+unary (numser_t res, const numser_t self, series_func_t f)
+{
+    struct numser * _res = res;
+    const struct numser * _self = self;
+    acb_poly_t t;
+
+    acb_poly_init(t);
+    f(t, _self -> dat, _res -> len, PREC);
+    acb_poly_swap(_res -> dat, t);
+    acb_poly_clear(t);
+}
+
+/****************************/
+/* User interface functions */
+/****************************/
+
+long
+numser_len (const numser_t self)
+{
+    const struct numser * _self = self;
+    return _self -> len;
+}
+
+void
+numser_set (numser_t self, const numser_t other)
+{
+    struct numser * _self = self;
+    const struct numser * _other = other;
+    acb_poly_set_trunc(_self -> dat, _other -> dat, _self -> len);
+}
+
+void
+numser_set_num (numser_t self, const num_t x)
+{
+    struct numser * _self = self;
+    const struct num * _x = x;
+    acb_poly_set_acb(_self -> dat, _x -> dat);
+}
+
+void
+numser_set_var (numser_t self, const num_t x)
+{
+    struct numser * _self = self;
+    const struct num * _x = x;
+
+    acb_poly_set_acb(_self -> dat, _x -> dat);
+    if (_self -> len > 1)
+        acb_poly_set_coeff_si(_self -> dat, 1, 1);
+}
+
+void
+numser_coeff (num_t res, const numser_t self, const long k)
+{
+    struct num * _res = num_writable_(res);
+    const struct numser * _self = self;
+
+    if (k < 0)
+        acb_zero(_res -> dat);
+    else
+        acb_poly_get_coeff_acb(_res -> dat, _self -> dat, k);
+}
+
+void
+numser_deriv (num_t res, const numser_t self, const long k)
+{
+    struct num * _res = num_writable_(res);
+    const struct numser * _self = self;
+    long i;
+
+    if (k < 0)
+    {
+        acb_zero(_res -> dat);
+        return;
+    }
+    acb_poly_get_coeff_acb(_res -> dat, _self -> dat, k);
+    for (i = 2; i <= k; i++)
+        acb_mul_ui(_res -> dat, _res -> dat, i, PREC);
+}
+
+/* Arithmetic */
+
+void
+numser_neg (numser_t res, const numser_t self)
+{
+    struct numser * _res = res;
+    const struct numser * _self = self;
+
+    acb_poly_neg(_res -> dat, _self -> dat);
+    acb_poly_truncate(_res -> dat, _res -> len);
+}
+
+void
+numser_add (numser_t res, const numser_t self, const numser_t other)
+{
+    struct numser * _res = res;
+    const struct numser * _self = self;
+    const struct numser * _other = other;
+
+    acb_poly_add(_res -> dat, _self -> dat, _other -> dat, PREC);
+    acb_poly_truncate(_res -> dat, _res -> len);
+}
+
+void
+numser_add_num (numser_t res, const numser_t self, const num_t other)
+{
+    struct numser * _res = res;
+    const struct numser * _self = self;
+    const struct num * _other = other;
+    acb_poly_t c;
+
+    acb_poly_init(c);
+    acb_poly_set_acb(c, _other -> dat);
+    acb_poly_add(_res -> dat, _self -> dat, c, PREC);
+    acb_poly_truncate(_res -> dat, _res -> len);
+    acb_poly_clear(c);
+}
+
+void
+numser_sub (numser_t res, const numser_t self, const numser_t other)
+{
+    struct numser * _res = res;
+    const struct numser * _self = self;
+    const struct numser * _other = other;
+
+    acb_poly_sub(_res -> dat, _self -> dat, _other -> dat, PREC);
+    acb_poly_truncate(_res -> dat, _res -> len);
+}
+
+void
+numser_mul (numser_t res, const numser_t self, const numser_t other)
+{
+    struct numser * _res = res;
+    const struct numser * _self = self;
+    const struct numser * _other = other;
+    acb_poly_mullow(_res -> dat, _self -> dat, _other -> dat, _res -> len, PREC);
+}
+
+void
+numser_mul_num (numser_t res, const numser_t self, const num_t other)
+{
+    struct numser * _res = res;
+    const struct numser * _self = self;
+    const struct num * _other = other;
+
+    acb_poly_scalar_mul(_res -> dat, _self -> dat, _other -> dat, PREC);
+    acb_poly_truncate(_res -> dat, _res -> len);
+}
+
+void
+numser_div (numser_t res, const numser_t self, const numser_t other)
+{
+    struct numser * _res = res;
+    const struct numser * _self = self;
+    const struct numser * _other = other;
+    acb_poly_div_series(_res -> dat, _self -> dat, _other -> dat, _res -> len, PREC);
+}
+
+void
+numser_pow (numser_t res, const numser_t self, const numser_t other)
+{
+    struct numser * _res = res;
+    const struct numser * _self = self;
+    const struct numser * _other = other;
+    acb_poly_t t;
+
+    acb_poly_init(t);
+    acb_poly_pow_series(t, _self -> dat, _other -> dat, _res -> len, PREC);
+    acb_poly_swap(_res -> dat, t);
+    acb_poly_clear(t);
+}
+
+void
+numser_pow_num (numser_t res, const numser_t self, const num_t other)
+{
+    struct numser * _res = res;
+    const struct numser * _self = self;
+    const struct num * _other = other;
+    acb_poly_t t;
+
+    acb_poly_init(t);
+    acb_poly_pow_acb_series(t, _self -> dat, _other -> dat, _res -> len, PREC);
+    acb_poly_swap(_res -> dat, t);
+    acb_poly_clear(t);
+}
+
+/* Unary functions */
+
+void
+numser_sqrt (numser_t res, const numser_t self)
+{
+    unary(res, self, acb_poly_sqrt_series);
+}
+
+void
+numser_exp (numser_t res, const numser_t self)
+{
+    unary(res, self, acb_poly_exp_series);
+}
+
+void
+numser_log (numser_t res, const numser_t self)
+{
+    unary(res, self, acb_poly_log_series);
+}
+
+void
+numser_sin (numser_t res, const numser_t self)
+{
+    unary(res, self, acb_poly_sin_series);
+}
+
+void
+numser_cos (numser_t res, const numser_t self)
+{
+    unary(res, self, acb_poly_cos_series);
+}
+
+void
+numser_atan (numser_t res, const numser_t self)
+{
+    unary(res, self, acb_poly_atan_series);
+}
+
+void
+numser_erf (numser_t res, const numser_t self)
+{
+    unary(res, self, acb_hypgeom_erf_series);
+}
+
+void
+numser_gamma (numser_t res, const numser_t self)
+{
+    unary(res, self, acb_poly_gamma_series);
+}
+
+void
+numser_rgamma (numser_t res, const numser_t self)
+{
+    unary(res, self, acb_poly_rgamma_series);
+}
+
+void
+numser_lgamma (numser_t res, const numser_t self)
+{
+    unary(res, self, acb_poly_lgamma_series);
+}
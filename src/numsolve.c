@@ -0,0 +1,339 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numsolve.c
+ * @brief Implementation of the root finders and minimizers.
+ */
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+
+#include "new.h"
+#include "num.h"
+#include "numsolve.h"
+
+/* Evaluates f at the double t and returns the midpoint of the result. */
+static double
+eval_d (num_func_t f, void * ctx, num_t x, num_t fx, const double t)
+{
+    num_set_d(x, t);
+    f(fx, x, ctx);
+
+    return num_real_d(fx);
+}
+
+/* Returns the sign of f(x): -1, 0 or 1, or 2 when it cannot be decided. */
+static int
+sign (const num_t fx, const num_t zero)
+{
+    if (num_is_zero(fx)) return 0;
+    if (num_lt(fx, zero)) return -1;
+    if (num_gt(fx, zero)) return 1;
+    return 2;
+}
+
+int
+num_solve_bisect (num_t root, num_func_t f, void * ctx,
+                  const num_t a, const num_t b, const double tol, const int maxiter)
+{
+    num_t lo, hi, mid, fx, zero;
+    int slo, shi, smid;
+    int i, status = NUM_SOLVE_MAXITER;
+
+    lo = new(num), hi = new(num), mid = new(num), fx = new(num), zero = new(num);
+    num_zero(zero);
+    num_set(lo, a), num_set(hi, b);
+
+    f(fx, lo, ctx), slo = sign(fx, zero);
+    f(fx, hi, ctx), shi = sign(fx, zero);
+    if (slo == 0)
+        num_set(hi, lo), status = NUM_SOLVE_OK;
+    else if (shi == 0)
+        num_set(lo, hi), status = NUM_SOLVE_OK;
+    else if (slo == 2 || shi == 2)
+        status = NUM_SOLVE_UNCERTAIN;
+    else if (slo == shi)
+        status = NUM_SOLVE_NO_BRACKET;
+    else
+        for (i = 0; i < maxiter; i++)
+        {
+            num_sub(mid, hi, lo);
+            num_abs(mid, mid);
+            if (num_real_d(mid) <= tol)
+            {
+                status = NUM_SOLVE_OK;
+                break;
+            }
+
+            num_add(mid, lo, hi);
+            num_mul_2exp(mid, mid, -1);
+            f(fx, mid, ctx), smid = sign(fx, zero);
+            if (smid == 0)
+            {
+                num_set(lo, mid), num_set(hi, mid);
+                status = NUM_SOLVE_OK;
+                break;
+            }
+            if (smid == 2)
+            {
+                status = NUM_SOLVE_UNCERTAIN;
+                break;
+            }
+            if (smid == slo)
+                num_set(lo, mid);
+            else
+                num_set(hi, mid);
+        }
+    num_union(root, lo, hi);
+
+    delete(lo), delete(hi), delete(mid), delete(fx), delete(zero);
+    return status;
+}
+
+int
+num_solve_brent (num_t root, num_func_t f, void * ctx,
+                 const num_t _a, const num_t _b, const double tol, const int maxiter)
+{
+    num_t x, fx;
+    double a = num_real_d(_a), b = num_real_d(_b), c, d, e;
+    double fa, fb, fc, p, q, r, s, tol1, xm;
+    int i, status = NUM_SOLVE_MAXITER;
+
+    x = new(num), fx = new(num);
+    fa = eval_d(f, ctx, x, fx, a);
+    fb = eval_d(f, ctx, x, fx, b);
+    if ((fa > 0.0 && fb > 0.0) || (fa < 0.0 && fb < 0.0))
+    {
+        delete(x), delete(fx);
+        return NUM_SOLVE_NO_BRACKET;
+    }
+
+    c = b, fc = fb, d = e = b - a;
+    for (i = 0; i < maxiter; i++)
+    {
+        if ((fb > 0.0 && fc > 0.0) || (fb < 0.0 && fc < 0.0))
+            c = a, fc = fa, d = e = b - a;
+        if (fabs(fc) < fabs(fb))
+        {
+            a = b, b = c, c = a;
+            fa = fb, fb = fc, fc = fa;
+        }
+
+        tol1 = 2.0 * DBL_EPSILON * fabs(b) + 0.5 * tol;
+        xm = 0.5 * (c - b);
+        if (fabs(xm) <= tol1 || fb == 0.0)
+        {
+            status = NUM_SOLVE_OK;
+            break;
+        }
+
+        if (fabs(e) >= tol1 && fabs(fa) > fabs(fb))
+        {
+            /* Inverse quadratic interpolation, or secant when a == c */
+            s = fb / fa;
+            if (a == c)
+            {
+                p = 2.0 * xm * s;
+                q = 1.0 - s;
+            }
+            else
+            {
+                q = fa / fc, r = fb / fc;
+                p = s * (2.0 * xm * q * (q - r) - (b - a) * (r - 1.0));
+                q = (q - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0.0) q = -q;
+            p = fabs(p);
+            if (2.0 * p < fmin(3.0 * xm * q - fabs(tol1 * q), fabs(e * q)))
+                e = d, d = p / q;
+            else
+                d = e = xm;
+        }
+        else
+            d = e = xm;
+
+        a = b, fa = fb;
+        b += (fabs(d) > tol1) ? d : copysign(tol1, xm);
+        fb = eval_d(f, ctx, x, fx, b);
+    }
+    num_set_d(root, b);
+
+    delete(x), delete(fx);
+    return status;
+}
+
+int
+num_solve_newton (num_t root, num_func_t f, num_func_t df, void * ctx,
+                  const num_t x0, const double tol, const int maxiter)
+{
+    num_t x, fx, dfx;
+    int i, status = NUM_SOLVE_MAXITER;
+
+    x = new(num), fx = new(num), dfx = new(num);
+    num_set(x, x0);
+    for (i = 0; i < maxiter; i++)
+    {
+        f(fx, x, ctx);
+        df(dfx, x, ctx);
+        if (num_is_zero(dfx))
+        {
+            status = NUM_SOLVE_ZERO_DERIVATIVE;
+            break;
+        }
+
+        num_div(fx, fx, dfx);
+        num_sub(x, x, fx);
+        num_abs(fx, fx);
+        if (num_real_d(fx) <= tol)
+        {
+            status = NUM_SOLVE_OK;
+            break;
+        }
+    }
+    num_set(root, x);
+
+    delete(x), delete(fx), delete(dfx);
+    return status;
+}
+
+int
+num_solve_halley (num_t root, num_func_t f, num_func_t df, num_func_t d2f, void * ctx,
+                  const num_t x0, const double tol, const int maxiter)
+{
+    num_t x, fx, dfx, d2fx, den;
+    int i, status = NUM_SOLVE_MAXITER;
+
+    x = new(num), fx = new(num), dfx = new(num), d2fx = new(num), den = new(num);
+    num_set(x, x0);
+    for (i = 0; i < maxiter; i++)
+    {
+        f(fx, x, ctx);
+        df(dfx, x, ctx);
+        d2f(d2fx, x, ctx);
+
+        /* step = 2 f f' / (2 f'^2 - f f'') */
+        num_mul(den, dfx, dfx);
+        num_mul_2exp(den, den, 1);
+        num_mul(d2fx, d2fx, fx);
+        num_sub(den, den, d2fx);
+        if (num_is_zero(den))
+        {
+            status = NUM_SOLVE_ZERO_DERIVATIVE;
+            break;
+        }
+        num_mul(fx, fx, dfx);
+        num_mul_2exp(fx, fx, 1);
+        num_div(fx, fx, den);
+
+        num_sub(x, x, fx);
+        num_abs(fx, fx);
+        if (num_real_d(fx) <= tol)
+        {
+            status = NUM_SOLVE_OK;
+            break;
+        }
+    }
+    num_set(root, x);
+
+    delete(x), delete(fx), delete(dfx), delete(d2fx), delete(den);
+    return status;
+}
+
+size_t
+num_solve_newton_vec (num_t* roots, int* status, num_func_t f, num_func_t df,
+                      void * const * ctx, const num_t* x0, const size_t n,
+                      const double tol, const int maxiter)
+{
+    num_t fx, dfx;
+    size_t i, active = n, done = 0;
+    int iter;
+
+    fx = new(num), dfx = new(num);
+    for (i = 0; i < n; i++)
+    {
+        num_set(roots[i], x0[i]);
+        status[i] = NUM_SOLVE_MAXITER;
+    }
+
+    for (iter = 0; iter < maxiter && active > 0; iter++)
+        for (i = 0; i < n; i++)
+        {
+            void * c = ctx ? ctx[i] : NULL;
+
+            if (status[i] != NUM_SOLVE_MAXITER) continue;
+
+            f(fx, roots[i], c);
+            df(dfx, roots[i], c);
+            if (num_is_zero(dfx))
+            {
+                status[i] = NUM_SOLVE_ZERO_DERIVATIVE;
+                active--;
+                continue;
+            }
+
+            num_div(fx, fx, dfx);
+            num_sub(roots[i], roots[i], fx);
+            num_abs(fx, fx);
+            if (num_real_d(fx) <= tol)
+            {
+                status[i] = NUM_SOLVE_OK;
+                active--, done++;
+            }
+        }
+
+    delete(fx), delete(dfx);
+    return done;
+}
+
+int
+num_minimize_golden (num_t xmin, num_func_t f, void * ctx,
+                     const num_t _a, const num_t _b, const double tol, const int maxiter)
+{
+    /* (3 - sqrt(5))/2 */
+    const double g = 0.38196601125010515;
+    num_t x, fx;
+    double a = num_real_d(_a), b = num_real_d(_b);
+    double x1, x2, f1, f2;
+    int i, status = NUM_SOLVE_MAXITER;
+
+    x = new(num), fx = new(num);
+    x1 = a + g * (b - a), f1 = eval_d(f, ctx, x, fx, x1);
+    x2 = b - g * (b - a), f2 = eval_d(f, ctx, x, fx, x2);
+    for (i = 0; i < maxiter; i++)
+    {
+        if (fabs(b - a) <= tol)
+        {
+            status = NUM_SOLVE_OK;
+            break;
+        }
+        if (f1 < f2)
+        {
+            b = x2, x2 = x1, f2 = f1;
+            x1 = a + g * (b - a), f1 = eval_d(f, ctx, x, fx, x1);
+        }
+        else
+        {
+            a = x1, x1 = x2, f1 = f2;
+            x2 = b - g * (b - a), f2 = eval_d(f, ctx, x, fx, x2);
+        }
+    }
+    num_set_d(xmin, 0.5 * (a + b));
+
+    delete(x), delete(fx);
+    return status;
+}
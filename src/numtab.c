@@ -0,0 +1,204 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numtab.c
+ * @brief Implementation of the interpolation tables for real functions.
+ */
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+#include "abc.h"
+#include "new.h"
+#include "num.h"
+#include "numtab.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Oversampling of the grid used to measure the error of the table */
+#define CHECK_FACTOR 4
+
+struct numtab
+{
+    const void * class; /* must be first */
+    num_unary_t f;
+    double a, b;
+    double inv_h; /* pieces / (b - a) */
+    int pieces;
+    int degree;
+    double * coef; /* (degree + 1) coefficients per piece */
+    double err;
+};
+
+/* Evaluates the tabulated function through the Arb backend. */
+static double
+numtab_reference (const struct numtab * self, num_t x, num_t y, const double t)
+{
+    num_set_d(x, t);
+    self -> f(y, x);
+
+    return num_real_d(y);
+}
+
+/* Chebyshev series of the piece containing x, evaluated by Clenshaw. */
+static double
+numtab_eval_piece (const struct numtab * self, const double x)
+{
+    const double u = (x - self -> a) * self -> inv_h;
+    int i = (int) u;
+
+    if (i >= self -> pieces) i = self -> pieces - 1;
+
+    const double t = 2.0 * (u - i) - 1.0;
+    const double * c = self -> coef + i * (self -> degree + 1);
+    double b1 = 0.0, b2 = 0.0;
+    int j;
+
+    for (j = self -> degree; j >= 1; j--)
+    {
+        const double b0 = 2.0 * t * b1 - b2 + c[j];
+        b2 = b1, b1 = b0;
+    }
+
+    return t * b1 - b2 + c[0];
+}
+
+static void
+numtab_fit (struct numtab * self)
+{
+    const int n = self -> degree + 1;
+    const double h = (self -> b - self -> a) / self -> pieces;
+    double * fx = malloc(n * sizeof(double));
+    num_t x, y;
+    int i, j, k;
+
+    assert(fx);
+    x = new(num), y = new(num);
+    for (i = 0; i < self -> pieces; i++)
+    {
+        double * c = self -> coef + i * n;
+        const double mid = self -> a + (i + 0.5) * h;
+
+        for (k = 0; k < n; k++)
+            fx[k] = numtab_reference(self, x, y,
+                                     mid + 0.5 * h * cos(M_PI * (k + 0.5) / n));
+        for (j = 0; j < n; j++)
+        {
+            double s = 0.0;
+
+            for (k = 0; k < n; k++)
+                s += fx[k] * cos(M_PI * j * (k + 0.5) / n);
+            c[j] = 2.0 * s / n;
+        }
+        c[0] *= 0.5;
+    }
+    free(fx);
+
+    /* Sample the error against the reference */
+    self -> err = 0.0;
+    for (k = 0; k <= CHECK_FACTOR * n * self -> pieces; k++)
+    {
+        const double t = self -> a + k * h / (CHECK_FACTOR * n);
+        const double e = fabs(numtab_eval_piece(self, t)
+                              - numtab_reference(self, x, y, t));
+
+        if (e > self -> err) self -> err = e;
+    }
+    self -> err *= 2.0;
+    delete(x), delete(y);
+}
+
+static void *
+numtab_ctor (void * self, va_list * app)
+{
+    struct numtab * _self = self;
+
+    _self -> f = va_arg(* app, num_unary_t);
+    _self -> a = va_arg(* app, double);
+    _self -> b = va_arg(* app, double);
+    _self -> pieces = va_arg(* app, int);
+    _self -> degree = va_arg(* app, int);
+    assert(_self -> f && _self -> b > _self -> a);
+    assert(_self -> pieces > 0 && _self -> degree >= 0);
+
+    _self -> inv_h = _self -> pieces / (_self -> b - _self -> a);
+    _self -> coef = malloc(_self -> pieces * (_self -> degree + 1) * sizeof(double));
+    assert(_self -> coef);
+    numtab_fit(_self);
+
+    return _self;
+}
+
+static void *
+numtab_dtor (void * self)
+{
+    struct numtab * _self = self;
+    free(_self -> coef);
+    return self;
+}
+
+static const struct ABC _numtab =
+{
+	sizeof(struct numtab),
+	numtab_ctor, numtab_dtor
+};
+
+const void * numtab = & _numtab;
+
+/****************************/
+/* User interface functions */
+/****************************/
+
+double
+numtab_eval_d (const numtab_t self, const double x)
+{
+    const struct numtab * _self = self;
+    num_t _x, _y;
+    double res;
+
+    if (x >= _self -> a && x <= _self -> b)
+        return numtab_eval_piece(_self, x);
+
+    _x = new(num), _y = new(num);
+    res = numtab_reference(_self, _x, _y, x);
+    delete(_x), delete(_y);
+
+    return res;
+}
+
+void
+numtab_eval_vec (const numtab_t self, double* res, const double* x, const size_t n)
+{
+    const struct numtab * _self = self;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        res[i] = (x[i] >= _self -> a && x[i] <= _self -> b)
+            ? numtab_eval_piece(_self, x[i])
+            : numtab_eval_d(self, x[i]);
+}
+
+double
+numtab_error_estimate (const numtab_t self)
+{
+    const struct numtab * _self = self;
+    return _self -> err;
+}
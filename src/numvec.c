@@ -0,0 +1,420 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file numvec.c
+ * @brief Implementation of the sorting, searching and selection kernels.
+ * @details Each value is reduced once to a 64-bit key whose unsigned order
+ * is the order of the midpoints. The (key, index) pairs are sorted by a
+ * least significant digit radix sort, which is stable, and the chunks
+ * sorted by different threads are merged pairwise, preferring the left
+ * chunk on ties so that the merge stays stable.
+ */
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "num.h"
+#include "numvec.h"
+#include "num_private.h"
+#include "parallel.h"
+
+/* Runs up to this length are sorted by insertion */
+#define INSERTION_MAX 32
+
+/* Below this length the sort runs in the calling thread */
+#define PARALLEL_MIN 16384
+
+struct item
+{
+    uint64_t key;
+    size_t idx;
+};
+
+/* Maps the real midpoint of x to a key with the same (unsigned) order */
+static uint64_t
+key (const num_t x)
+{
+    const struct num * _x = x;
+    union { double d; uint64_t u; } v;
+
+    if (_x -> tag == NUM_TAG_SI)
+        v.d = (double) _x -> si;
+    else
+        v.d = arf_get_d(arb_midref(acb_realref(_x -> dat)), ARF_RND_NEAR);
+    if (v.d != v.d) return UINT64_MAX;
+    /* -0 sorts as +0 */
+    if (v.d == 0.0) v.d = 0.0;
+
+    return (v.u >> 63) ? ~v.u : v.u | ((uint64_t) 1 << 63);
+}
+
+/* Order of the items, the index breaking the ties */
+static bool
+less (const struct item a, const struct item b)
+{
+    return a.key < b.key || (a.key == b.key && a.idx < b.idx);
+}
+
+static void
+swap (struct item * a, const size_t i, const size_t j)
+{
+    struct item t = a[i];
+    a[i] = a[j], a[j] = t;
+}
+
+static struct item *
+make_items (const num_t * x, const size_t n)
+{
+    struct item * a = malloc(n * sizeof(struct item));
+    size_t i;
+
+    assert(a || n == 0);
+    for (i = 0; i < n; i++)
+        a[i].key = key(x[i]), a[i].idx = i;
+    return a;
+}
+
+/* Permutes the pointers of x as the sorted items */
+static void
+apply_items (num_t * x, const struct item * a, const size_t n)
+{
+    num_t * y = malloc(n * sizeof(num_t));
+    size_t i;
+
+    assert(y || n == 0);
+    memcpy(y, x, n * sizeof(num_t));
+    for (i = 0; i < n; i++)
+        x[i] = y[a[i].idx];
+    free(y);
+}
+
+/***********/
+/* Sorting */
+/***********/
+
+static void
+insertion_sort (struct item * a, const size_t n)
+{
+    size_t i, j;
+
+    for (i = 1; i < n; i++)
+    {
+        struct item t = a[i];
+        for (j = i; j > 0 && a[j - 1].key > t.key; j--)
+            a[j] = a[j - 1];
+        a[j] = t;
+    }
+}
+
+/* Sorts a by key, stably, using tmp (of the same length) as scratch */
+static void
+radix_sort (struct item * a, struct item * tmp, const size_t n)
+{
+    size_t count[256], i, sum, c;
+    struct item * src = a, * dst = tmp, * t;
+    int shift;
+
+    if (n <= INSERTION_MAX)
+    {
+        insertion_sort(a, n);
+        return;
+    }
+
+    for (shift = 0; shift < 64; shift += 8)
+    {
+        memset(count, 0, sizeof(count));
+        for (i = 0; i < n; i++)
+            count[(src[i].key >> shift) & 0xff]++;
+        /* Every key has the same digit here */
+        if (count[(src[0].key >> shift) & 0xff] == n) continue;
+
+        for (sum = 0, i = 0; i < 256; i++)
+            c = count[i], count[i] = sum, sum += c;
+        for (i = 0; i < n; i++)
+            dst[count[(src[i].key >> shift) & 0xff]++] = src[i];
+        t = src, src = dst, dst = t;
+    }
+    if (src != a) memcpy(a, src, n * sizeof(struct item));
+}
+
+static void
+merge (struct item * dst, const struct item * a, const size_t na,
+       const struct item * b, const size_t nb)
+{
+    size_t i = 0, j = 0, k = 0;
+
+    while (i < na && j < nb)
+        dst[k++] = (b[j].key < a[i].key) ? b[j++] : a[i++];
+    while (i < na) dst[k++] = a[i++];
+    while (j < nb) dst[k++] = b[j++];
+}
+
+struct sort
+{
+    struct item * a;
+    struct item * tmp;
+    size_t n, nchunks, width;
+};
+
+static size_t
+chunk_begin (const struct sort * s, const size_t c)
+{
+    return (c >= s -> nchunks) ? s -> n : c * s -> n / s -> nchunks;
+}
+
+static void
+sort_chunks (size_t begin, size_t end, void * arg)
+{
+    const struct sort * s = arg;
+    size_t c, lo, hi;
+
+    for (c = begin; c < end; c++)
+    {
+        lo = chunk_begin(s, c), hi = chunk_begin(s, c + 1);
+        radix_sort(s -> a + lo, s -> tmp + lo, hi - lo);
+    }
+}
+
+/* Merges the runs of width chunks two by two, from a into tmp */
+static void
+merge_runs (size_t begin, size_t end, void * arg)
+{
+    const struct sort * s = arg;
+    size_t p, lo, mid, hi;
+
+    for (p = begin; p < end; p++)
+    {
+        lo = chunk_begin(s, 2 * p * s -> width);
+        mid = chunk_begin(s, (2 * p + 1) * s -> width);
+        hi = chunk_begin(s, (2 * p + 2) * s -> width);
+        merge(s -> tmp + lo, s -> a + lo, mid - lo, s -> a + mid, hi - mid);
+    }
+}
+
+static void
+sort_items (struct item * a, const size_t n, const int nthreads)
+{
+    struct sort s;
+    struct item * t;
+
+    s.a = a, s.n = n;
+    s.tmp = malloc(n * sizeof(struct item));
+    assert(s.tmp || n == 0);
+    s.nchunks = (n >= PARALLEL_MIN && nthreads > 1) ? (size_t) nthreads : 1;
+
+    parallel_for(s.nchunks, nthreads, sort_chunks, &s);
+    for (s.width = 1; s.width < s.nchunks; s.width *= 2)
+    {
+        parallel_for((s.nchunks + 2 * s.width - 1) / (2 * s.width), nthreads, merge_runs, &s);
+        t = s.a, s.a = s.tmp, s.tmp = t;
+    }
+
+    if (s.a != a)
+    {
+        memcpy(a, s.a, n * sizeof(struct item));
+        free(s.a);
+    }
+    else
+        free(s.tmp);
+}
+
+/*************/
+/* Selection */
+/*************/
+
+/* Moves the k-th smallest item of a to a[k], by quickselect */
+static void
+select_item (struct item * a, const size_t n, const size_t k)
+{
+    size_t lo = 0, hi = n, mid, i, store;
+
+    while (hi - lo > 1)
+    {
+        /* Median of three, moved to a[hi - 1] as the pivot */
+        mid = lo + (hi - lo) / 2;
+        if (less(a[mid], a[lo])) swap(a, lo, mid);
+        if (less(a[hi - 1], a[lo])) swap(a, lo, hi - 1);
+        if (less(a[mid], a[hi - 1])) swap(a, mid, hi - 1);
+
+        for (store = lo, i = lo; i < hi - 1; i++)
+            if (less(a[i], a[hi - 1])) swap(a, i, store++);
+        swap(a, store, hi - 1);
+
+        if (k == store) return;
+        if (k < store)
+            hi = store;
+        else
+            lo = store + 1;
+    }
+}
+
+/*********/
+/* Masks */
+/*********/
+
+static bool
+is_real (const struct num * x)
+{
+    return x -> tag == NUM_TAG_SI || arb_is_zero(acb_imagref(x -> dat));
+}
+
+static bool
+is_zero (const struct num * x)
+{
+    return (x -> tag == NUM_TAG_SI) ? x -> si == 0 : acb_is_zero(x -> dat);
+}
+
+static bool
+lt (const struct num * x, const struct num * y)
+{
+    if (x -> tag == NUM_TAG_SI && y -> tag == NUM_TAG_SI)
+        return x -> si < y -> si;
+    return arb_lt(acb_realref(x -> dat), acb_realref(y -> dat));
+}
+
+/*
+ * Each word is assembled from 64 predicates without branching on them;
+ * bit is the predicate of value i, for i from begin to end.
+ */
+#define MASK_LOOP(mask, n, bit)                                 \
+    do {                                                        \
+        size_t w_, i;                                           \
+        for (w_ = 0; w_ < ((n) + 63) / 64; w_++)                \
+        {                                                       \
+            const size_t begin = 64 * w_;                       \
+            const size_t end = (begin + 64 < (n)) ? begin + 64 : (n); \
+            uint64_t word = 0;                                  \
+            for (i = begin; i < end; i++)                       \
+                word |= (uint64_t) (bit) << (i - begin);        \
+            (mask)[w_] = word;                                  \
+        }                                                       \
+    } while (0)
+
+/****************************/
+/* User interface functions */
+/****************************/
+
+void
+numvec_sort (num_t* x, const size_t n, const int nthreads)
+{
+    struct item * a = make_items(x, n);
+
+    sort_items(a, n, nthreads);
+    apply_items(x, a, n);
+    free(a);
+}
+
+void
+numvec_argsort (size_t* perm, const num_t* x, const size_t n, const int nthreads)
+{
+    struct item * a = make_items(x, n);
+    size_t i;
+
+    sort_items(a, n, nthreads);
+    for (i = 0; i < n; i++)
+        perm[i] = a[i].idx;
+    free(a);
+}
+
+void
+numvec_nth_element (num_t* x, const size_t k, const size_t n)
+{
+    struct item * a;
+
+    assert(k < n);
+    a = make_items(x, n);
+    select_item(a, n, k);
+    apply_items(x, a, n);
+    free(a);
+}
+
+size_t
+numvec_searchsorted (const num_t* x, const size_t n, const num_t v)
+{
+    const uint64_t kv = key(v);
+    size_t lo = 0, hi = n, mid;
+
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (key(x[mid]) < kv)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+void
+numvec_is_real_mask (uint64_t* mask, const num_t* x, const size_t n)
+{
+    MASK_LOOP(mask, n, is_real(x[i]));
+}
+
+void
+numvec_is_zero_mask (uint64_t* mask, const num_t* x, const size_t n)
+{
+    MASK_LOOP(mask, n, is_zero(x[i]));
+}
+
+void
+numvec_lt_mask (uint64_t* mask, const num_t* x, const num_t* y, const size_t n)
+{
+    MASK_LOOP(mask, n, lt(x[i], y[i]));
+}
+
+void
+numvec_lt_d_mask (uint64_t* mask, const num_t* x, const size_t n, const double v)
+{
+    struct num o;
+
+    o.class = num;
+    acb_init(o.dat);
+    acb_set_d(o.dat, v);
+    o.tag = NUM_TAG_ACB;
+    MASK_LOOP(mask, n, lt(x[i], &o));
+    acb_clear(o.dat);
+}
+
+size_t
+numvec_mask_count (const uint64_t* mask, const size_t n)
+{
+    size_t count = 0, w;
+    uint64_t word;
+
+    for (w = 0; w < (n + 63) / 64; w++)
+        /* Clears the lowest set bit until none is left */
+        for (word = mask[w]; word != 0; word &= word - 1)
+            count++;
+    return count;
+}
+
+size_t
+numvec_compress (num_t* dst, const num_t* src, const uint64_t* mask, const size_t n)
+{
+    size_t i, k = 0;
+
+    /* dst[k] is overwritten until a selected value moves k forward */
+    for (i = 0; i < n; i++)
+    {
+        dst[k] = src[i];
+        k += (mask[i / 64] >> (i % 64)) & 1;
+    }
+    return k;
+}
@@ -0,0 +1,79 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file parallel.c
+ * @brief Implementation of the internal parallel loop.
+ */
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "num.h"
+#include "parallel.h"
+
+struct block
+{
+    parallel_body_t body;
+    void * arg;
+    size_t begin, end;
+};
+
+static void *
+parallel_worker (void * _block)
+{
+    struct block * block = _block;
+
+    num_thread_init();
+    block -> body(block -> begin, block -> end, block -> arg);
+    num_thread_cleanup();
+
+    return NULL;
+}
+
+void
+parallel_for (size_t n, int nthreads, parallel_body_t body, void * arg)
+{
+    struct block * blocks;
+    pthread_t * threads;
+    size_t t, nt;
+
+    if (nthreads < 2 || n < 2)
+    {
+        body(0, n, arg);
+        return;
+    }
+
+    nt = ((size_t) nthreads < n) ? (size_t) nthreads : n;
+    blocks = malloc(nt * sizeof(struct block));
+    threads = malloc(nt * sizeof(pthread_t));
+    assert(blocks && threads);
+
+    for (t = 0; t < nt; t++)
+    {
+        blocks[t].body = body, blocks[t].arg = arg;
+        blocks[t].begin = t * n / nt;
+        blocks[t].end = (t + 1) * n / nt;
+    }
+    for (t = 1; t < nt; t++)
+        pthread_create(&threads[t], NULL, parallel_worker, &blocks[t]);
+    body(blocks[0].begin, blocks[0].end, arg);
+    for (t = 1; t < nt; t++)
+        pthread_join(threads[t], NULL);
+
+    free(blocks), free(threads);
+}
@@ -0,0 +1,42 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file parallel.h
+ * @brief Interface of the internal parallel loop.
+ */
+#ifndef __PARALLEL_H__
+#define __PARALLEL_H__
+
+#include <stddef.h>
+
+/**
+ * Body of a parallel loop, run on the indices \f$[begin, end)\f$.
+ */
+typedef void (* parallel_body_t) (size_t begin, size_t end, void * arg);
+
+/**
+ * Splits \f$[0, n)\f$ in \p nthreads contiguous blocks of nearly equal size
+ * and runs \p body on each of them, one block per thread. The calling
+ * thread takes the first block. Returns when all the blocks are done.
+ *
+ * With \p nthreads below 2 the loop runs in the calling thread.
+ */
+void
+parallel_for (size_t n, int nthreads, parallel_body_t body, void * arg);
+
+#endif /* __PARALLEL_H__ */
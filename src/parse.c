@@ -0,0 +1,409 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file parse.c
+ * @brief Implementation of the conversions from text.
+ * @details A decimal \f$M \cdot 10^e\f$ is rounded to nearest at the
+ * working precision, and the radius is set to one ulp when the rounding is
+ * inexact. When \f$M < 2^{53}\f$ and \f$|e| \le 22\f$ both factors are
+ * exact doubles and a single double operation is correctly rounded
+ * (Clinger's fast path); otherwise \f$M\f$ and \f$10^{|e|}\f$ go through
+ * FLINT integers. Both paths give the same ball. The bulk parser finds the
+ * delimiters with memchr(), which the C library vectorizes.
+ */
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "num.h"
+#include "num_private.h"
+
+#include <arb.h>
+#include <acb.h>
+
+/* Largest number of significant digits accumulated in a uint64_t */
+#define DIGITS_MAX 19
+
+/* Beyond this decimal exponent the literal is left to arb_set_str() */
+#define EXP10_MAX 10000
+
+static const double exact_pow10[23] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static bool
+is_blank (const char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static bool
+is_digit (const char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static void
+trim (const char ** s, const char ** e)
+{
+    while (* s < * e && is_blank(** s)) (* s)++;
+    while (* e > * s && is_blank((* e)[-1])) (* e)--;
+}
+
+/* Returns true iff [s, e) is word, ignoring the case */
+static bool
+is_word (const char * s, const char * e, const char * word)
+{
+    for (; s < e && * word; s++, word++)
+        if ((* s | 0x20) != * word) return false;
+    return s == e && * word == '\0';
+}
+
+/* Sets res to the exact decimal m 10^e rounded as described above */
+static void
+set_decimal_fmpz (arb_t res, const fmpz_t m, const slong e)
+{
+    fmpz_t p, q;
+    arf_t a, b;
+    int inexact;
+
+    fmpz_init(p), fmpz_init(q);
+    fmpz_ui_pow_ui(p, 10, (e >= 0) ? e : -e);
+    if (e >= 0)
+    {
+        fmpz_mul(q, m, p);
+        inexact = arf_set_round_fmpz(arb_midref(res), q, PREC, ARF_RND_NEAR);
+    }
+    else
+    {
+        arf_init(a), arf_init(b);
+        arf_set_fmpz(a, m), arf_set_fmpz(b, p);
+        inexact = arf_div(arb_midref(res), a, b, PREC, ARF_RND_NEAR);
+        arf_clear(a), arf_clear(b);
+    }
+    if (inexact)
+        arf_mag_set_ulp(arb_radref(res), arb_midref(res), PREC);
+    else
+        mag_zero(arb_radref(res));
+    fmpz_clear(p), fmpz_clear(q);
+}
+
+static void
+set_decimal_d (arb_t res, const uint64_t m, const int e)
+{
+    const double dm = (double) m;
+    double r;
+    bool exact;
+
+    if (e >= 0)
+        r = dm * exact_pow10[e], exact = (fma(dm, exact_pow10[e], -r) == 0.0);
+    else
+        r = dm / exact_pow10[-e], exact = (fma(r, exact_pow10[-e], -dm) == 0.0);
+
+    arf_set_d(arb_midref(res), r);
+    if (exact)
+        mag_zero(arb_radref(res));
+    else
+        arf_mag_set_ulp(arb_radref(res), arb_midref(res), PREC);
+}
+
+/* Hands [s, e) to arb_set_str(), which needs a terminated string */
+static bool
+parse_arb_str (arb_t res, const char * s, const char * e)
+{
+    char * buf = malloc(e - s + 1);
+    bool ok;
+
+    assert(buf);
+    memcpy(buf, s, e - s), buf[e - s] = '\0';
+    ok = (arb_set_str(res, buf, PREC) == 0);
+    free(buf);
+
+    return ok;
+}
+
+/* Parses a signed decimal literal, "inf" or "nan" */
+static bool
+parse_decimal (arb_t res, const char * s, const char * e)
+{
+    const char * start = s, * int0, * int1, * frac0, * frac1, * d;
+    bool neg = false, eneg = false;
+    slong exp10 = 0, nsig = 0;
+    uint64_t m = 0;
+
+    if (s < e && (* s == '+' || * s == '-')) neg = (* s++ == '-');
+    if (is_word(s, e, "inf"))
+    {
+        if (neg)
+            arb_neg_inf(res);
+        else
+            arb_pos_inf(res);
+        return true;
+    }
+    if (is_word(s, e, "nan"))
+    {
+        arb_indeterminate(res);
+        return true;
+    }
+
+    for (int0 = s; s < e && is_digit(* s); s++);
+    int1 = s;
+    if (s < e && * s == '.') s++;
+    for (frac0 = s; s < e && is_digit(* s); s++);
+    frac1 = s;
+    if (int0 == int1 && frac0 == frac1) return false;
+    if (s < e && (* s == 'e' || * s == 'E'))
+    {
+        s++;
+        if (s < e && (* s == '+' || * s == '-')) eneg = (* s++ == '-');
+        if (s == e || !is_digit(* s)) return false;
+        for (; s < e && is_digit(* s); s++)
+            if (exp10 < 10 * EXP10_MAX) exp10 = 10 * exp10 + (* s - '0');
+        if (eneg) exp10 = -exp10;
+    }
+    if (s != e) return false;
+    exp10 -= frac1 - frac0;
+
+    /* Significant digits, leading zeros excluded */
+    for (d = int0; d < frac1; d++)
+    {
+        if (d == int1) d = frac0;
+        if (d == frac1) break;
+        if (nsig > 0 || * d != '0') nsig++;
+    }
+    if (exp10 > EXP10_MAX || exp10 < -EXP10_MAX)
+        return parse_arb_str(res, start, e);
+
+    if (nsig <= DIGITS_MAX)
+    {
+        for (d = int0; d < frac1; d++)
+        {
+            if (d == int1) d = frac0;
+            if (d == frac1) break;
+            m = 10 * m + (* d - '0');
+        }
+        if (m < ((uint64_t) 1 << 53) && exp10 >= -22 && exp10 <= 22)
+            set_decimal_d(res, m, exp10);
+        else
+        {
+            fmpz_t M;
+            fmpz_init(M);
+            fmpz_set_ui(M, m);
+            set_decimal_fmpz(res, M, exp10);
+            fmpz_clear(M);
+        }
+    }
+    else
+    {
+        char * digits = malloc(frac1 - int0 + 1);
+        size_t k = 0;
+        fmpz_t M;
+
+        assert(digits);
+        for (d = int0; d < frac1; d++)
+            if (is_digit(* d)) digits[k++] = * d;
+        digits[k] = '\0';
+        fmpz_init(M);
+        fmpz_set_str(M, digits, 10);
+        set_decimal_fmpz(res, M, exp10);
+        fmpz_clear(M);
+        free(digits);
+    }
+    if (neg) arb_neg(res, res);
+
+    return true;
+}
+
+/* Parses a decimal or a ball: "[m +/- r]", "m +/- r" or "[+/- r]" */
+static bool
+parse_real (arb_t res, const char * s, const char * e)
+{
+    const char * pm;
+    arb_t r;
+    bool ok;
+
+    trim(&s, &e);
+    if (s < e && * s == '[')
+    {
+        if (e[-1] != ']') return false;
+        s++, e--;
+        trim(&s, &e);
+    }
+    for (pm = s; pm + 3 <= e && memcmp(pm, "+/-", 3) != 0; pm++);
+    if (pm + 3 > e)
+        return parse_decimal(res, s, e);
+
+    arb_init(r);
+    if (pm == s)
+    {
+        arb_zero(res);
+        ok = true;
+    }
+    else
+        ok = parse_real(res, s, pm);
+    ok = ok && parse_real(r, pm + 3, e);
+    if (ok) arb_add_error(res, r);
+    arb_clear(r);
+
+    return ok;
+}
+
+/*
+ * Parses a real or a complex number "a+bi", "a-bi", "bi" or "i", where a and
+ * b are reals in the syntax of parse_real(), balls being bracketed.
+ */
+static bool
+parse_num (acb_t res, const char * s, const char * e)
+{
+    const char * q;
+    int depth = 0;
+
+    trim(&s, &e);
+    if (s == e) return false;
+    if (e[-1] != 'i' && e[-1] != 'I' && e[-1] != 'j')
+    {
+        arb_zero(acb_imagref(res));
+        return parse_real(acb_realref(res), s, e);
+    }
+    e--;
+
+    /* The sign starting the imaginary part, skipping exponents and balls */
+    for (q = e; q > s; q--)
+    {
+        const char c = q[-1];
+        if (c == ']') depth++;
+        if (c == '[') depth--;
+        if (depth == 0 && (c == '+' || c == '-') && q - 1 > s
+            && q[-2] != 'e' && q[-2] != 'E' && q[-2] != '/')
+            break;
+    }
+    if (q > s)
+        q--;
+    else
+        q = s;
+
+    if (q == s)
+        arb_zero(acb_realref(res));
+    else if (!parse_real(acb_realref(res), s, q))
+        return false;
+
+    trim(&q, &e);
+    if (e - q <= 1 && (q == e || * q == '+' || * q == '-'))
+    {
+        arb_one(acb_imagref(res));
+        if (q < e && * q == '-') arb_neg(acb_imagref(res), acb_imagref(res));
+        return true;
+    }
+    if (* q == '+' || * q == '-')
+    {
+        const bool neg = (* q == '-');
+        q++;
+        if (!parse_real(acb_imagref(res), q, e)) return false;
+        if (neg) arb_neg(acb_imagref(res), acb_imagref(res));
+        return true;
+    }
+    return parse_real(acb_imagref(res), q, e);
+}
+
+/****************************/
+/* User interface functions */
+/****************************/
+
+bool
+num_set_str (num_t self, const char* str)
+{
+    struct num * _self = self;
+    acb_t t;
+    bool ok;
+
+    acb_init(t);
+    ok = parse_num(t, str, str + strlen(str));
+    if (ok)
+    {
+        num_writable_(self);
+        acb_swap(_self -> dat, t);
+    }
+    acb_clear(t);
+
+    return ok;
+}
+
+/* The real part of num_set_str(), for numr_set_str() */
+bool
+num_arb_set_str_ (arb_t res, const char* str)
+{
+    const char * s = str, * e = str + strlen(str);
+    arb_t t;
+    bool ok;
+
+    trim(&s, &e);
+    if (s == e) return false;
+
+    arb_init(t);
+    ok = parse_real(t, s, e);
+    if (ok) arb_swap(res, t);
+    arb_clear(t);
+
+    return ok;
+}
+
+size_t
+num_set_str_vec (num_t* res, const size_t n, const char* text, const size_t len)
+{
+    const char * p = text, * end = text + len, * line, * field, * s, * e;
+    size_t k = 0;
+    acb_t t;
+
+    acb_init(t);
+    while (p < end && k < n)
+    {
+        line = memchr(p, '\n', end - p);
+        if (!line) line = end;
+        for (; k < n; p = field + 1)
+        {
+            field = memchr(p, ',', line - p);
+            if (!field) field = line;
+
+            s = p, e = field;
+            trim(&s, &e);
+            if (s < e)
+            {
+                struct num * r = res[k];
+                if (!parse_num(t, s, e))
+                {
+                    acb_clear(t);
+                    return k;
+                }
+                num_writable_(r);
+                acb_swap(r -> dat, t);
+                k++;
+            }
+            if (field == line) break;
+        }
+        /* line + 1 would be past the end of the text */
+        if (line == end) break;
+        p = line + 1;
+    }
+    acb_clear(t);
+
+    return k;
+}
@@ -0,0 +1,419 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file profile.c
+ * @brief Implementation of the latency profiler.
+ * @details With NUM_PROFILE defined, this file provides a __wrap_num_f()
+ * for every function f listed below, and the Makefile links with
+ * --wrap=num_f, so that the calls to num_f() from the other object files go
+ * through the wrapper, which times __real_num_f(). The calls made inside
+ * num.c are not redirected. Each thread records into its own histograms,
+ * under a lock which only num_profile_dump() and num_profile_reset()
+ * contend for; the histograms of an exiting thread are merged into those
+ * of the retired threads.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <complex.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "num.h"
+#include "numprof.h"
+#include "num_private.h"
+
+#include <acb.h>
+
+/* The profiled functions, by signature; the Makefile reads the lists */
+#define UNARY_FUNCTIONS(X) \
+    X(real) X(imag) X(mid) X(abs) X(neg) X(inv) X(conj) X(ceil) X(arg) \
+    X(sqrt) X(cbrt) X(rsqrt) X(exp) X(expm1) X(exp_pi_i) X(log) X(log1p) \
+    X(sin) X(cos) X(tan) X(sinh) X(cosh) X(atan) X(asin) X(acos) \
+    X(erf) X(erfc) X(gamma) X(rgamma) X(lgamma) X(digamma)
+
+#define BINARY_FUNCTIONS(X) \
+    X(add) X(sub) X(mul) X(div) X(fmod) X(pow) X(atan2) X(max) X(union) \
+    X(bessel_j) X(bessel_y) X(bessel_i) X(bessel_k) X(expint) X(incgamma)
+
+/* num_f (res, x, scalar) */
+#define D_FUNCTIONS(X) X(add_d) X(sub_d) X(mul_d) X(div_d) X(pow_d)
+#define SI_FUNCTIONS(X) X(add_si) X(sub_si) X(mul_si) X(div_si) X(pow_si) X(mul_2exp)
+#define UI_FUNCTIONS(X) X(div_ui)
+#define C_FUNCTIONS(X) X(add_c) X(sub_c) X(mul_c) X(div_c)
+
+/* num_f (res, scalar, y) */
+#define LEFT_D_FUNCTIONS(X) X(d_div)
+#define LEFT_SI_FUNCTIONS(X) X(si_div)
+#define LEFT_C_FUNCTIONS(X) X(c_div)
+
+/* num_f (s, c, x) */
+#define PAIR_FUNCTIONS(X) X(sin_cos) X(sinh_cosh) X(sin_cos_pi)
+
+#define TERNARY_FUNCTIONS(X) X(hyp1f1) X(max3)
+#define QUATERNARY_FUNCTIONS(X) X(hyp2f1)
+
+#define ALL_FUNCTIONS(X) \
+    UNARY_FUNCTIONS(X) BINARY_FUNCTIONS(X) \
+    D_FUNCTIONS(X) SI_FUNCTIONS(X) UI_FUNCTIONS(X) C_FUNCTIONS(X) \
+    LEFT_D_FUNCTIONS(X) LEFT_SI_FUNCTIONS(X) LEFT_C_FUNCTIONS(X) \
+    PAIR_FUNCTIONS(X) TERNARY_FUNCTIONS(X) QUATERNARY_FUNCTIONS(X)
+
+#define FUNCTION_ID(f) PROFILE_##f,
+#define FUNCTION_NAME(f) "num_" #f,
+
+enum
+{
+    ALL_FUNCTIONS(FUNCTION_ID)
+    NFUNCTIONS
+};
+
+static const char * const function_names[NFUNCTIONS] =
+{
+    ALL_FUNCTIONS(FUNCTION_NAME)
+};
+
+enum
+{
+    CLASS_ZERO,
+    CLASS_TINY,
+    CLASS_SMALL,
+    CLASS_UNIT,
+    CLASS_LARGE,
+    CLASS_HUGE,
+    CLASS_NONFINITE,
+    NCLASSES
+};
+
+static const char * const class_names[NCLASSES] =
+{
+    "zero", "tiny", "small", "unit", "large", "huge", "nonfinite"
+};
+
+/* Buckets per power of two of nanoseconds */
+#define SUB 4
+/* Latencies up to 2^40 ns, about 18 minutes */
+#define NBUCKETS (SUB * 40)
+
+struct histogram
+{
+    unsigned long count;
+    double total, max;
+    unsigned long buckets[NBUCKETS];
+};
+
+/* The histograms of one thread, or those of the retired threads */
+struct table
+{
+    struct histogram h[NFUNCTIONS][NCLASSES];
+    pthread_mutex_t lock;
+    struct table * next;
+};
+
+/* Guards the list of live tables and the retired one */
+static pthread_mutex_t profile_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct table * live = NULL;
+static struct table retired = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+/* Lower bound, in ns, of bucket b */
+static double
+bucket_low (const int b)
+{
+    return ldexp(1.0 + (double) (b % SUB) / SUB, b / SUB);
+}
+
+/* Upper bound, in ns, of the bucket holding the q-quantile of h */
+static double
+quantile (const struct histogram * h, const double q)
+{
+    unsigned long seen = 0;
+    int b;
+
+    for (b = 0; b < NBUCKETS - 1; b++)
+    {
+        seen += h -> buckets[b];
+        if (seen >= q * h -> count) break;
+    }
+    return bucket_low(b + 1);
+}
+
+/* Adds the histograms of src, under its lock, to dst */
+static void
+merge (struct table * dst, struct table * src)
+{
+    int f, c, b;
+
+    pthread_mutex_lock(&src -> lock);
+    for (f = 0; f < NFUNCTIONS; f++)
+        for (c = 0; c < NCLASSES; c++)
+        {
+            struct histogram * d = &dst -> h[f][c];
+            const struct histogram * s = &src -> h[f][c];
+
+            d -> count += s -> count;
+            d -> total += s -> total;
+            if (s -> max > d -> max) d -> max = s -> max;
+            for (b = 0; b < NBUCKETS; b++)
+                d -> buckets[b] += s -> buckets[b];
+        }
+    pthread_mutex_unlock(&src -> lock);
+}
+
+#ifdef NUM_PROFILE
+
+static pthread_once_t key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t table_key;
+static FLINT_TLS_PREFIX struct table * thread_table = NULL;
+
+/* Runs at the exit of a thread which recorded calls */
+static void
+retire (void * arg)
+{
+    struct table * t = arg, ** p;
+
+    pthread_mutex_lock(&profile_lock);
+    merge(&retired, t);
+    for (p = &live; * p != t; p = &(* p) -> next);
+    * p = t -> next;
+    pthread_mutex_unlock(&profile_lock);
+
+    pthread_mutex_destroy(&t -> lock);
+    free(t);
+}
+
+static void
+make_key (void)
+{
+    pthread_key_create(&table_key, retire);
+}
+
+static struct table *
+table (void)
+{
+    struct table * t = thread_table;
+
+    if (t) return t;
+
+    t = calloc(1, sizeof(struct table));
+    if (t == NULL) return NULL;
+    pthread_mutex_init(&t -> lock, NULL);
+    pthread_once(&key_once, make_key);
+    pthread_setspecific(table_key, t);
+
+    pthread_mutex_lock(&profile_lock);
+    t -> next = live, live = t;
+    pthread_mutex_unlock(&profile_lock);
+
+    return thread_table = t;
+}
+
+static double
+now (void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+static int
+bucket (const double ns)
+{
+    int e, b;
+    double f;
+
+    if (ns < 1.0) return 0;
+    /* ns = f 2^e, with 1/2 <= f < 1 */
+    f = frexp(ns, &e);
+    b = SUB * (e - 1) + (int) ((2.0 * f - 1.0) * SUB);
+    return (b < NBUCKETS) ? b : NBUCKETS - 1;
+}
+
+static double
+magnitude (const num_t x)
+{
+    const struct num * _x = x;
+    const double re = fabs(arf_get_d(arb_midref(acb_realref(_x -> dat)), ARF_RND_UP));
+    const double im = fabs(arf_get_d(arb_midref(acb_imagref(_x -> dat)), ARF_RND_UP));
+
+    return (re > im) ? re : im;
+}
+
+/* Class of the largest of the n arguments x */
+static int
+magnitude_class (const num_t * x, const int n)
+{
+    double m = 0.0;
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        const struct num * _x = x[i];
+
+        if (!acb_is_finite(_x -> dat)) return CLASS_NONFINITE;
+        if (magnitude(x[i]) > m) m = magnitude(x[i]);
+    }
+
+    if (m == 0.0) return CLASS_ZERO;
+    if (m < ldexp(1.0, -20)) return CLASS_TINY;
+    if (m < 1.0) return CLASS_SMALL;
+    if (m < 16.0) return CLASS_UNIT;
+    if (m < ldexp(1.0, 20)) return CLASS_LARGE;
+    return CLASS_HUGE;
+}
+
+static void
+record (const int f, const int c, const double seconds)
+{
+    struct table * t = table();
+    struct histogram * h;
+    const double ns = 1e9 * seconds;
+
+    if (t == NULL) return;
+    h = &t -> h[f][c];
+
+    /* Only contended by a concurrent dump or reset */
+    pthread_mutex_lock(&t -> lock);
+    h -> count++;
+    h -> total += ns;
+    if (ns > h -> max) h -> max = ns;
+    h -> buckets[bucket(ns)]++;
+    pthread_mutex_unlock(&t -> lock);
+}
+
+/*
+ * The wrapper of f, with parameters params, called with args; the class is
+ * that of the num arguments, taken before the call, which may overwrite them.
+ * The locals end with _ so as not to shadow the parameters.
+ */
+#define WRAPPER(f, params, args, ...)                                   \
+    void __real_num_##f params;                                         \
+    void __wrap_num_##f params;                                         \
+    void                                                                \
+    __wrap_num_##f params                                               \
+    {                                                                   \
+        const num_t in_[] = {__VA_ARGS__};                              \
+        const int class_ = magnitude_class(in_, sizeof(in_) / sizeof(in_[0])); \
+        const double start_ = now();                                    \
+        __real_num_##f args;                                            \
+        record(PROFILE_##f, class_, now() - start_);                    \
+    }
+
+#define UNARY_WRAPPER(f) \
+    WRAPPER(f, (num_t res, const num_t x), (res, x), x)
+#define BINARY_WRAPPER(f) \
+    WRAPPER(f, (num_t res, const num_t x, const num_t y), (res, x, y), x, y)
+#define D_WRAPPER(f) \
+    WRAPPER(f, (num_t res, const num_t x, const double y), (res, x, y), x)
+#define SI_WRAPPER(f) \
+    WRAPPER(f, (num_t res, const num_t x, const long y), (res, x, y), x)
+#define UI_WRAPPER(f) \
+    WRAPPER(f, (num_t res, const num_t x, const unsigned long y), (res, x, y), x)
+#define C_WRAPPER(f) \
+    WRAPPER(f, (num_t res, const num_t x, const double complex y), (res, x, y), x)
+#define LEFT_D_WRAPPER(f) \
+    WRAPPER(f, (num_t res, const double x, const num_t y), (res, x, y), y)
+#define LEFT_SI_WRAPPER(f) \
+    WRAPPER(f, (num_t res, const long x, const num_t y), (res, x, y), y)
+#define LEFT_C_WRAPPER(f) \
+    WRAPPER(f, (num_t res, const double complex x, const num_t y), (res, x, y), y)
+#define PAIR_WRAPPER(f) \
+    WRAPPER(f, (num_t s, num_t c, const num_t x), (s, c, x), x)
+#define TERNARY_WRAPPER(f) \
+    WRAPPER(f, (num_t res, const num_t x, const num_t y, const num_t z), (res, x, y, z), x, y, z)
+#define QUATERNARY_WRAPPER(f)                                                           \
+    WRAPPER(f, (num_t res, const num_t x, const num_t y, const num_t z, const num_t w), \
+            (res, x, y, z, w), x, y, z, w)
+
+UNARY_FUNCTIONS(UNARY_WRAPPER)
+BINARY_FUNCTIONS(BINARY_WRAPPER)
+D_FUNCTIONS(D_WRAPPER)
+SI_FUNCTIONS(SI_WRAPPER)
+UI_FUNCTIONS(UI_WRAPPER)
+C_FUNCTIONS(C_WRAPPER)
+LEFT_D_FUNCTIONS(LEFT_D_WRAPPER)
+LEFT_SI_FUNCTIONS(LEFT_SI_WRAPPER)
+LEFT_C_FUNCTIONS(LEFT_C_WRAPPER)
+PAIR_FUNCTIONS(PAIR_WRAPPER)
+TERNARY_FUNCTIONS(TERNARY_WRAPPER)
+QUATERNARY_FUNCTIONS(QUATERNARY_WRAPPER)
+
+#endif /* NUM_PROFILE */
+
+/****************************/
+/* User interface functions */
+/****************************/
+
+void
+num_profile_dump (FILE* out)
+{
+    struct table * sum = calloc(1, sizeof(struct table)), * t;
+    const struct histogram * h;
+    bool first = true, first_bucket;
+    int f, c, b;
+
+    if (sum == NULL) return;
+    pthread_mutex_lock(&profile_lock);
+    merge(sum, &retired);
+    for (t = live; t; t = t -> next)
+        merge(sum, t);
+    pthread_mutex_unlock(&profile_lock);
+
+    fprintf(out, "{\"functions\": [");
+    for (f = 0; f < NFUNCTIONS; f++)
+        for (c = 0; c < NCLASSES; c++)
+        {
+            h = &sum -> h[f][c];
+            if (h -> count == 0) continue;
+
+            fprintf(out, "%s\n  {\"function\": \"%s\", \"class\": \"%s\", \"calls\": %lu, "
+                    "\"mean_ns\": %.0f, \"p50_ns\": %.0f, \"p99_ns\": %.0f, \"max_ns\": %.0f, "
+                    "\"buckets\": [", first ? "" : ",", function_names[f], class_names[c],
+                    h -> count, h -> total / h -> count, quantile(h, 0.5), quantile(h, 0.99),
+                    h -> max);
+            for (first_bucket = true, b = 0; b < NBUCKETS; b++)
+                if (h -> buckets[b] > 0)
+                {
+                    fprintf(out, "%s[%.0f, %lu]", first_bucket ? "" : ", ",
+                            bucket_low(b), h -> buckets[b]);
+                    first_bucket = false;
+                }
+            fprintf(out, "]}");
+            first = false;
+        }
+    fprintf(out, "\n]}\n");
+    free(sum);
+}
+
+void
+num_profile_reset (void)
+{
+    struct table * t;
+
+    pthread_mutex_lock(&profile_lock);
+    memset(retired.h, 0, sizeof(retired.h));
+    for (t = live; t; t = t -> next)
+    {
+        pthread_mutex_lock(&t -> lock);
+        memset(t -> h, 0, sizeof(t -> h));
+        pthread_mutex_unlock(&t -> lock);
+    }
+    pthread_mutex_unlock(&profile_lock);
+}
@@ -0,0 +1,120 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file reduce.c
+ * @brief Implementation of the reproducible reductions.
+ * @details The blocks are the unit of work handed to the threads, so which
+ * thread sums a block never changes the value of its partial sum.
+ */
+#include "num.h"
+#include "num_private.h"
+#include "parallel.h"
+
+#include <acb.h>
+
+/* Number of terms summed by one acb_dot() call */
+#define BLOCK 128
+
+struct reduce
+{
+    acb_ptr partial;
+    const num_t * x;
+    const num_t * y;
+    size_t n;
+};
+
+/*
+ * acb_dot() wants contiguous operands: the terms of a block are copied
+ * shallowly to the stack, and only read from there.
+ */
+static void
+reduce_blocks (size_t begin, size_t end, void * arg)
+{
+    const struct reduce * r = arg;
+    acb_struct x[BLOCK], y[BLOCK];
+    acb_t one;
+    size_t b, i, len;
+
+    acb_init(one);
+    acb_one(one);
+    for (b = begin; b < end; b++)
+    {
+        len = (r -> n - b * BLOCK < BLOCK) ? r -> n - b * BLOCK : BLOCK;
+        for (i = 0; i < len; i++)
+        {
+            const struct num * xi = r -> x[b * BLOCK + i];
+            x[i] = * xi -> dat;
+            if (r -> y)
+            {
+                const struct num * yi = r -> y[b * BLOCK + i];
+                y[i] = * yi -> dat;
+            }
+        }
+        if (r -> y)
+            acb_dot(r -> partial + b, NULL, 0, x, 1, y, 1, len, PREC);
+        else
+            acb_dot(r -> partial + b, NULL, 0, x, 1, one, 0, len, PREC);
+    }
+    acb_clear(one);
+}
+
+static void
+reduce (num_t res, const num_t * x, const num_t * y, const size_t n, const int nthreads)
+{
+    struct num * _res = num_writable_(res);
+    const size_t nblocks = (n + BLOCK - 1) / BLOCK;
+    struct reduce r;
+    size_t i, w;
+
+    if (n == 0)
+    {
+        acb_zero(_res -> dat);
+        return;
+    }
+
+    r.partial = _acb_vec_init(nblocks);
+    r.x = x, r.y = y, r.n = n;
+    parallel_for(nblocks, nthreads, reduce_blocks, &r);
+
+    /* Fixed pairwise tree over the partial sums */
+    for (w = 1; w < nblocks; w *= 2)
+        for (i = 0; i + w < nblocks; i += 2 * w)
+            acb_add(r.partial + i, r.partial + i, r.partial + i + w, PREC);
+
+    if (num_thread_mode == NUM_MODE_MID)
+        acb_get_mid(_res -> dat, r.partial);
+    else
+        acb_set(_res -> dat, r.partial);
+    _acb_vec_clear(r.partial, nblocks);
+}
+
+/****************************/
+/* User interface functions */
+/****************************/
+
+void
+num_sum_vec (num_t res, const num_t* x, const size_t n, const int nthreads)
+{
+    reduce(res, x, NULL, n, nthreads);
+}
+
+void
+num_dot_vec (num_t res, const num_t* x, const num_t* y, const size_t n, const int nthreads)
+{
+    reduce(res, x, y, n, nthreads);
+}
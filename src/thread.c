@@ -0,0 +1,252 @@
+/*
+ * This file is part of num.c (https://github.com/padawanphysicist/num.c).
+ *
+ * num.c is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * num.c is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * num.c. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file thread.c
+ * @brief Per-thread cache management and memory accounting.
+ * @details The memory functions handed to FLINT keep the blocks allocated by
+ * the system allocator, so memory obtained before num_thread_init() can
+ * still be released after it. The size of each block is taken from the
+ * allocator itself, with malloc_usable_size() on glibc and malloc_size() on
+ * macOS; elsewhere the memory functions are not replaced and the counters
+ * stay at zero. All the counters are per thread, and a block freed by
+ * another thread than the one which allocated it is accounted to the
+ * thread freeing it.
+ */
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#define BLOCK_SIZE(p) malloc_usable_size(p)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define BLOCK_SIZE(p) malloc_size(p)
+#endif
+
+#include "num.h"
+#include "num_private.h"
+
+#include <flint/flint.h>
+#include <acb.h>
+#include <acb_hypgeom.h>
+
+static FLINT_TLS_PREFIX long thread_bytes = 0;
+static FLINT_TLS_PREFIX long thread_peak = 0;
+static FLINT_TLS_PREFIX long thread_allocations = 0;
+
+static pthread_once_t memory_once = PTHREAD_ONCE_INIT;
+
+#ifdef BLOCK_SIZE
+
+/* Accounts for a change of delta bytes, from count new blocks */
+static void
+account (const long delta, const long count)
+{
+    thread_bytes += delta;
+    thread_allocations += count;
+    if (thread_bytes > thread_peak) thread_peak = thread_bytes;
+}
+
+static void *
+num_malloc (size_t size)
+{
+    void * p = malloc(size);
+
+    if (p) account(BLOCK_SIZE(p), 1);
+    return p;
+}
+
+static void *
+num_calloc (size_t n, size_t size)
+{
+    void * p = calloc(n, size);
+
+    if (p) account(BLOCK_SIZE(p), 1);
+    return p;
+}
+
+static void
+num_free (void * ptr)
+{
+    if (ptr) account(-(long) BLOCK_SIZE(ptr), 0);
+    free(ptr);
+}
+
+static void *
+num_realloc (void * ptr, size_t size)
+{
+    size_t old;
+    void * p;
+
+    /* realloc(NULL, size) is malloc(size), and realloc(ptr, 0) may free ptr */
+    if (ptr == NULL) return num_malloc(size);
+    if (size == 0)
+    {
+        num_free(ptr);
+        return NULL;
+    }
+
+    old = BLOCK_SIZE(ptr);
+    p = realloc(ptr, size);
+    if (p) account((long) BLOCK_SIZE(p) - (long) old, 0);
+    return p;
+}
+
+static void
+num_install_memory_functions (void)
+{
+    __flint_set_memory_functions(num_malloc, num_calloc, num_realloc, num_free);
+}
+
+#else
+
+/* The size of a block is unknown: nothing is accounted */
+static void
+num_install_memory_functions (void)
+{
+}
+
+#endif /* BLOCK_SIZE */
+
+/***********/
+/* Warm-up */
+/***********/
+
+struct warmup
+{
+    const char * name;
+    void (* f) (acb_t, const acb_t, slong);
+};
+
+static const struct warmup warmups[] =
+{
+    {"exp", acb_exp},
+    {"log", acb_log},
+    {"sin", acb_sin},
+    {"cos", acb_cos},
+    {"atan", acb_atan},
+    {"erf", acb_hypgeom_erf},
+    {"erfc", acb_hypgeom_erfc},
+    {"gamma", acb_gamma},
+    {"rgamma", acb_hypgeom_rgamma},
+    {"lgamma", acb_lgamma},
+    {"digamma", acb_digamma}
+};
+#define NWARMUPS (sizeof(warmups) / sizeof(warmups[0]))
+
+/*
+ * Arguments reaching the different algorithms: the Taylor series near zero,
+ * the argument reductions and the asymptotic expansions, whose Bernoulli
+ * numbers are cached
+ */
+static const double warmup_args[][2] =
+{
+    {0.25, 0.0}, {3.7, 0.0}, {30.5, 0.0}, {-2.3, 1.1}, {0.5, 12.0}
+};
+#define NARGS (sizeof(warmup_args) / sizeof(warmup_args[0]))
+
+static void
+warmup_function (const struct warmup * w, const slong prec)
+{
+    acb_t x, y;
+    size_t k;
+
+    acb_init(x), acb_init(y);
+    for (k = 0; k < NARGS; k++)
+    {
+        acb_set_d_d(x, warmup_args[k][0], warmup_args[k][1]);
+        w -> f(y, x, prec);
+    }
+    acb_clear(x), acb_clear(y);
+}
+
+/****************************/
+/* User interface functions */
+/****************************/
+
+void
+num_thread_init (void)
+{
+    pthread_once(&memory_once, num_install_memory_functions);
+}
+
+void
+num_thread_cleanup (void)
+{
+    flint_cleanup();
+}
+
+bool
+num_warmup (const char* functions, const long prec)
+{
+    const slong p = (prec > PREC) ? prec : PREC;
+    const char * s = functions, * e;
+    bool known = true, found;
+    size_t k, len;
+
+    num_const_warmup(p);
+    if (functions == NULL)
+    {
+        for (k = 0; k < NWARMUPS; k++)
+            warmup_function(&warmups[k], p);
+        return true;
+    }
+
+    for (; * s; s = e + (* e == ','))
+    {
+        e = s + strcspn(s, ",");
+        len = e - s;
+        if (len == 0) continue;
+
+        found = false;
+        for (k = 0; k < NWARMUPS; k++)
+            if (strlen(warmups[k].name) == len && memcmp(warmups[k].name, s, len) == 0)
+            {
+                warmup_function(&warmups[k], p);
+                found = true;
+            }
+        known = known && found;
+    }
+    return known;
+}
+
+long
+num_thread_memory (void)
+{
+    return thread_bytes;
+}
+
+long
+num_thread_memory_peak (void)
+{
+    return thread_peak;
+}
+
+long
+num_thread_allocations (void)
+{
+    return thread_allocations;
+}
+
+void
+num_thread_memory_reset (void)
+{
+    thread_peak = thread_bytes;
+    thread_allocations = 0;
+}
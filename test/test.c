@@ -1,16 +1,33 @@
 #include "unity.h"
 #include "num.h"
 #include "new.h"
-
+#include "num_inline.h"
+#include "num_generic.h"
+#include "numtab.h"
+#include "numsolve.h"
+#include "numquad.h"
+#include "numser.h"
+#include "numvec.h"
+#include "numpipe.h"
+#include "numprof.h"
+#include "numr.h"
+
+#include <limits.h>
+#include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 #ifndef M_PI
-#define M_PI 3.14159265358979323844
+#define M_PI 3.14159265358979323846
 #endif
 
 /* delta value for float comparison */
 #define DELTA 1e-15
 
+#define UNUSED(x) (void)(x)
+
 void
 setUp (void)
 {
@@ -93,6 +110,170 @@ test_is_not_real_I (void)
     TEST_ASSERT_MESSAGE(res, "I is real(?)");
 }
 
+void
+test_num_set_si (void)
+{
+    num_t x;
+    double res_si, res_ui;
+
+    x = new(num);
+    num_set_si(x, -42);
+    res_si = num_to_d(x);
+    num_set_ui(x, 42);
+    res_ui = num_to_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(-42.0, res_si);
+    TEST_ASSERT_EQUAL_DOUBLE(42.0, res_ui);
+}
+
+void
+test_num_set_fmpz (void)
+{
+    num_t x;
+    fmpz_t n;
+    double res;
+
+    x = new(num);
+    fmpz_init(n);
+    fmpz_set_si(n, 123456789);
+    num_set_fmpz(x, n);
+    res = num_to_d(x);
+    fmpz_clear(n);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(123456789.0, res);
+}
+
+void
+test_num_set_q (void)
+{
+    num_t x;
+    fmpq_t q;
+    double res;
+
+    x = new(num);
+    fmpq_init(q);
+    fmpq_set_si(q, 1, 3);
+    num_set_q(x, q);
+    res = num_to_d(x);
+    fmpq_clear(q);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.0 / 3.0, res);
+}
+
+void
+test_num_mode_mid (void)
+{
+    num_t x, y;
+    double rad_ball, rad_mid, res;
+
+    x = new(num), y = new(num);
+    num_set_d(x, 3.0);
+    num_inv(x, x);
+    num_add(y, x, x);
+    rad_ball = num_rad_d(y);
+    num_set_mode(NUM_MODE_MID);
+    num_add(y, x, x);
+    num_mul(y, y, x);
+    num_div(y, y, x);
+    rad_mid = num_rad_d(y);
+    res = num_to_d(y);
+    num_set_mode(NUM_MODE_BALL);
+    delete(x), delete(y);
+
+    TEST_ASSERT_MESSAGE(rad_ball > 0.0, "inexact sum has zero radius");
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, rad_mid);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0 / 3.0, res);
+}
+
+void
+test_num_rel_accuracy_bits (void)
+{
+    num_t x;
+    long exact, inexact;
+    double rad;
+
+    x = new(num);
+    num_set_d(x, 3.0);
+    exact = num_rel_accuracy_bits(x);
+    num_inv(x, x);
+    inexact = num_rel_accuracy_bits(x);
+    num_mid(x, x);
+    rad = num_rad_d(x);
+    delete(x);
+
+    TEST_ASSERT_MESSAGE(inexact < exact, "1/3 is as accurate as 3 (?)");
+    TEST_ASSERT_MESSAGE(inexact >= 50, "1/3 lost too many bits");
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, rad);
+}
+
+void
+test_num_inline (void)
+{
+    num_t x, y, z;
+    double complex res;
+    double re;
+    bool zero;
+
+    x = new(num), y = new(num), z = new(num);
+    num_set_d_d(x, 3.0, 4.0);
+    num_set_inline(y, x);
+    num_conj_inline(y, y);
+    num_mul_inline(z, x, y);
+    num_add_inline(z, z, x);
+    num_sub_inline(z, z, y);
+    num_neg_inline(z, z);
+    res = num_to_complex(z);
+    re = num_real_d_inline(z);
+    num_sub_inline(z, x, x);
+    zero = num_is_zero_inline(z);
+    delete(x), delete(y), delete(z);
+
+    /* -((3+4i)(3-4i) + (3+4i) - (3-4i)) = -25 - 8i */
+    TEST_ASSERT_EQUAL_DOUBLE(-25.0, creal(res));
+    TEST_ASSERT_EQUAL_DOUBLE(-8.0, cimag(res));
+    TEST_ASSERT_EQUAL_DOUBLE(-25.0, re);
+    TEST_ASSERT_MESSAGE(zero, "x - x is not zero");
+}
+
+void
+test_num_small_int (void)
+{
+    num_t x, y, z;
+    double sq, twice, prod;
+    bool stale;
+
+    x = new(num), y = new(num), z = new(num);
+    num_set_si(x, -7);
+    num_abs(x, x);
+    num_set_d(y, 6.0);
+    num_mul(z, x, y);
+    num_sub_si(z, z, 2);
+    prod = num_to_d(z);
+
+    /* Overflowing operands fall back to Arb */
+    num_set_si(x, 3037000500L);
+    num_mul(z, x, x);
+    sq = num_to_d(z);
+    num_set_si(x, LONG_MAX);
+    num_add(z, x, x);
+    twice = num_to_d(z);
+
+    /* A value written by Arb must not keep its old tag */
+    num_set_si(x, 4);
+    num_sqrt(x, x);
+    num_set_si(y, 4);
+    stale = !num_lt(x, y) || !num_eq_d(x, 2.0);
+    delete(x), delete(y), delete(z);
+
+    TEST_ASSERT_EQUAL_DOUBLE(40.0, prod);
+    TEST_ASSERT_EQUAL_DOUBLE(9223372037000250000.0, sq);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0 * (double) LONG_MAX, twice);
+    TEST_ASSERT_FALSE(stale);
+}
+
 void
 test_num_to_d (void)
 {
@@ -298,6 +479,238 @@ test_num_cos (void)
     TEST_ASSERT_EQUAL_DOUBLE(-0.511822569987385, cimag(res));
 }
 
+void
+test_num_tan (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_set_d(x, 1.0);
+    num_tan(x, x);
+    res = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.5574077246549023, res);
+}
+
+void
+test_num_atan (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_set_d(x, 1.0);
+    num_atan(x, x);
+    res = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(0.25 * M_PI, res);
+}
+
+void
+test_num_asin (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_set_d(x, 0.5);
+    num_asin(x, x);
+    res = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(M_PI / 6.0, res);
+}
+
+void
+test_num_acos (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_set_d(x, 0.5);
+    num_acos(x, x);
+    res = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(M_PI / 3.0, res);
+}
+
+void
+test_num_atan2 (void)
+{
+    num_t x, y;
+    double res;
+
+    x = new(num), y = new(num);
+    num_set_d(y, 1.0);
+    num_set_d(x, -1.0);
+    num_atan2(x, y, x);
+    res = num_to_d(x);
+    delete(x), delete(y);
+
+    TEST_ASSERT_EQUAL_DOUBLE(0.75 * M_PI, res);
+}
+
+void
+test_num_log1p (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_set_d(x, 1e-10);
+    num_log1p(x, x);
+    res = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(9.9999999995e-11, res);
+}
+
+void
+test_num_expm1 (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_set_d(x, 1e-10);
+    num_expm1(x, x);
+    res = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.00000000005e-10, res);
+}
+
+void
+test_num_cbrt (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_set_d(x, -8.0);
+    num_cbrt(x, x);
+    res = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(-2.0, res);
+}
+
+void
+test_num_cbrt_straddle (void)
+{
+    num_t x, y;
+    double lo, hi;
+
+    /* The ball [-3, 1] */
+    x = new(num), y = new(num);
+    num_set_d(x, -3.0);
+    num_set_d(y, 1.0);
+    num_union(x, x, y);
+    num_cbrt(x, x);
+    lo = num_real_d(x) - num_rad_d(x);
+    hi = num_real_d(x) + num_rad_d(x);
+    delete(x), delete(y);
+
+    TEST_ASSERT_TRUE(lo <= -1.4422495703074083);
+    TEST_ASSERT_TRUE(hi >= 1.0);
+}
+
+void
+test_num_rsqrt (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_set_d(x, 4.0);
+    num_rsqrt(x, x);
+    res = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(0.5, res);
+}
+
+void
+test_num_sin_cos (void)
+{
+    num_t x, s, c;
+    double complex sin_res, cos_res;
+
+    x = new(num), s = new(num), c = new(num);
+    num_set_d_d(x, 3.0, 4.0);
+    num_sin_cos(s, c, x);
+    sin_res = num_to_complex(s);
+    num_set_d_d(x, 3.0, 2.0);
+    num_sin_cos(s, c, x);
+    cos_res = num_to_complex(c);
+    delete(x), delete(s), delete(c);
+
+    TEST_ASSERT_EQUAL_DOUBLE(3.85373803791938, creal(sin_res));
+    TEST_ASSERT_EQUAL_DOUBLE(-27.0168132580039, cimag(sin_res));
+    TEST_ASSERT_EQUAL_DOUBLE(-3.72454550491532,  creal(cos_res));
+    TEST_ASSERT_EQUAL_DOUBLE(-0.511822569987385, cimag(cos_res));
+}
+
+void
+test_num_sinh_cosh (void)
+{
+    num_t x, s, c;
+    double sinh_res, cosh_res;
+
+    x = new(num), s = new(num), c = new(num);
+    num_one(x);
+    num_sinh_cosh(s, c, x);
+    sinh_res = num_real_d(s), cosh_res = num_real_d(c);
+    delete(x), delete(s), delete(c);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.1752011936438014, sinh_res);
+    TEST_ASSERT_EQUAL_DOUBLE(1.5430806348152437, cosh_res);
+}
+
+void
+test_num_exp_pi_i (void)
+{
+    num_t x;
+    double complex res;
+
+    x = new(num);
+    num_set_d(x, 0.5);
+    num_exp_pi_i(x, x);
+    res = num_to_complex(x);
+    delete(x);
+
+    TEST_ASSERT_DOUBLE_WITHIN(DELTA, 0.0, creal(res));
+    TEST_ASSERT_DOUBLE_WITHIN(DELTA, 1.0, cimag(res));
+}
+
+void
+test_num_sin_cos_pi_vec (void)
+{
+    num_t x[2], s[2], c[2];
+    double res[4];
+    int i;
+
+    for (i = 0; i < 2; i++)
+        x[i] = new(num), s[i] = new(num), c[i] = new(num);
+    num_set_d(x[0], 1.0 / 6.0);
+    num_set_d(x[1], 1.0);
+    num_sin_cos_pi_vec(s, c, x, 2);
+    res[0] = num_real_d(s[0]), res[1] = num_real_d(c[0]);
+    res[2] = num_real_d(s[1]), res[3] = num_real_d(c[1]);
+    for (i = 0; i < 2; i++)
+        delete(x[i]), delete(s[i]), delete(c[i]);
+
+    TEST_ASSERT_EQUAL_DOUBLE(0.5, res[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.8660254037844386, res[1]);
+    TEST_ASSERT_DOUBLE_WITHIN(DELTA, 0.0, res[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(-1.0, res[3]);
+}
+
 void
 test_num_add (void)
 {
@@ -366,6 +779,58 @@ test_num_div (void)
     TEST_ASSERT_EQUAL_DOUBLE(1.0, cimag(res));
 }
 
+void
+test_num_scalar_forms (void)
+{
+    num_t x;
+    double complex res;
+
+    x = new(num);
+    num_set_d_d(x, 3.0, 4.0);
+    num_add_si(x, x, 1);
+    num_sub_d(x, x, 0.5);
+    num_mul_c(x, x, 2.0 * I);
+    num_div_si(x, x, 2);
+    num_sub_c(x, x, 1.0 + 1.0 * I);
+    res = num_to_complex(x);
+    delete(x);
+
+    /* (3.5 + 4i) * 2i / 2 - (1 + i) = -5 + 2.5i */
+    TEST_ASSERT_EQUAL_DOUBLE(-5.0, creal(res));
+    TEST_ASSERT_EQUAL_DOUBLE(2.5, cimag(res));
+}
+
+void
+test_num_generic (void)
+{
+    num_t x, y;
+    double complex res;
+    double res_d;
+    long n = 3;
+    bool exact;
+
+    x = new(num), y = new(num);
+    num_set_d(x, 2.0);
+    NUM_MUL(y, x, x);
+    NUM_ADD(y, y, 1.5);
+    NUM_SUB(y, 10, y);
+    NUM_DIV(y, y, n);
+    res_d = num_to_d(y);
+    NUM_MUL(y, 1.0 * I, x);
+    NUM_DIV(y, 4.0, y);
+    res = num_to_complex(y);
+    num_set_d(x, 3.0);
+    NUM_DIV(y, 6, x);
+    exact = num_eq_d(y, 2.0) && num_rad_d(y) == 0.0;
+    delete(x), delete(y);
+
+    /* (10 - (2*2 + 1.5))/3 = 1.5, 4/(2i) = -2i, 6/3 = 2 exactly */
+    TEST_ASSERT_EQUAL_DOUBLE(1.5, res_d);
+    TEST_ASSERT_TRUE(exact);
+    TEST_ASSERT_DOUBLE_WITHIN(DELTA, 0.0, creal(res));
+    TEST_ASSERT_EQUAL_DOUBLE(-2.0, cimag(res));
+}
+
 void
 test_num_fmod (void)
 {
@@ -399,6 +864,45 @@ test_num_pow (void)
     TEST_ASSERT_EQUAL_DOUBLE(24.0, cimag(res));
 }
 
+void
+test_num_pow_classes (void)
+{
+    num_t x, y;
+    double complex r[6];
+    double e, l;
+
+    x = new(num), y = new(num);
+    num_set_si(x, -3), num_set_si(y, 5);
+    num_pow(x, x, y), r[0] = num_to_complex(x);
+    num_set_d(x, 4.0), num_set_d(y, 2.5);
+    num_pow(x, x, y), r[1] = num_to_complex(x);
+    num_set_d(x, -4.0), num_set_d(y, 0.5);
+    num_pow(x, x, y), r[2] = num_to_complex(x);
+    num_set_d(x, 2.0), num_set_si(y, -2);
+    num_pow(x, x, y), r[3] = num_to_complex(x);
+    num_set_d(x, 2.5), num_set_d(y, 1.3);
+    num_pow(y, x, y), r[4] = num_to_complex(y);
+    num_set_d(x, -1.0);
+    num_log(x, x), r[5] = num_to_complex(x);
+    num_set_d(x, 1.0);
+    num_exp(x, x), e = num_to_d(x);
+    num_set_d(x, 2.0);
+    num_log(x, x), l = num_to_d(x);
+    delete(x), delete(y);
+
+    TEST_ASSERT_EQUAL_DOUBLE(-243.0, creal(r[0]));
+    TEST_ASSERT_EQUAL_DOUBLE(32.0, creal(r[1]));
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, creal(r[2]));
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, cimag(r[2]));
+    TEST_ASSERT_EQUAL_DOUBLE(0.25, creal(r[3]));
+    TEST_ASSERT_EQUAL_DOUBLE(pow(2.5, 1.3), creal(r[4]));
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, cimag(r[4]));
+    /* Negative arguments still take the complex branch */
+    TEST_ASSERT_EQUAL_DOUBLE(3.14159265358979323846, cimag(r[5]));
+    TEST_ASSERT_EQUAL_DOUBLE(2.71828182845904523536, e);
+    TEST_ASSERT_EQUAL_DOUBLE(0.69314718055994530942, l);
+}
+
 void
 test_num_pow_d (void)
 {
@@ -416,28 +920,90 @@ test_num_pow_d (void)
 }
 
 void
-test_num_pow_cmplx (void)
+test_num_pow_si (void)
 {
-    num_t x, y;
+    num_t x;
     double complex res;
 
-    x = new(num), y = new(num);
+    x = new(num);
     num_set_d_d(x, 3.0, 4.0);
-    num_set_d_d(y, 0.0, 2.0);
-    num_pow(x, x, y);
-    res  = num_to_complex(x);
-    delete(x), delete(y);
+    num_pow_si(x, x, 2);
+    res = num_to_complex(x);
+    delete(x);
 
-    TEST_ASSERT_EQUAL_DOUBLE(-0.156049852140608, creal(res));
-    TEST_ASSERT_EQUAL_DOUBLE(-0.0120840952149667, cimag(res));
+    TEST_ASSERT_EQUAL_DOUBLE(-7.0, creal(res));
+    TEST_ASSERT_EQUAL_DOUBLE(24.0, cimag(res));
 }
 
 void
-test_num_eq (void)
+test_num_mul_si (void)
 {
-    num_t x, y;
-    bool res;
-
+    num_t x;
+    double complex res;
+
+    x = new(num);
+    num_set_d_d(x, 3.0, 4.0);
+    num_mul_si(x, x, -3);
+    res = num_to_complex(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(-9.0, creal(res));
+    TEST_ASSERT_EQUAL_DOUBLE(-12.0, cimag(res));
+}
+
+void
+test_num_mul_2exp (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_set_d(x, 3.0);
+    num_mul_2exp(x, x, -2);
+    res = num_to_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(0.75, res);
+}
+
+void
+test_num_div_ui (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_set_si(x, 10);
+    num_div_ui(x, x, 4);
+    res = num_to_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(2.5, res);
+}
+
+void
+test_num_pow_cmplx (void)
+{
+    num_t x, y;
+    double complex res;
+
+    x = new(num), y = new(num);
+    num_set_d_d(x, 3.0, 4.0);
+    num_set_d_d(y, 0.0, 2.0);
+    num_pow(x, x, y);
+    res  = num_to_complex(x);
+    delete(x), delete(y);
+
+    TEST_ASSERT_EQUAL_DOUBLE(-0.156049852140608, creal(res));
+    TEST_ASSERT_EQUAL_DOUBLE(-0.0120840952149667, cimag(res));
+}
+
+void
+test_num_eq (void)
+{
+    num_t x, y;
+    bool res;
+
     x = new(num), y = new(num);
     num_set_d_d(x, 3.0, 4.0);
     num_set_d_d(y, 3.0, 4.0);
@@ -588,9 +1154,1350 @@ test_num_max (void)
     TEST_ASSERT_EQUAL_DOUBLE(10.0, res);
 }
 
+void
+test_num_gamma (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_set_d(x, 5.0);
+    num_gamma(x, x);
+    res = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(24.0, res);
+}
+
+void
+test_num_lgamma (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_set_d(x, 10.0);
+    num_lgamma(x, x);
+    res = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(12.8018274800814696, res);
+}
+
+void
+test_num_digamma (void)
+{
+    num_t x;
+    double res;
+
+    x = new(num);
+    num_one(x);
+    num_digamma(x, x);
+    res = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(-0.5772156649015329, res);
+}
+
+void
+test_num_bessel (void)
+{
+    num_t nu, z, x;
+    double j, y, i, k;
+
+    nu = new(num), z = new(num), x = new(num);
+    num_zero(nu);
+    num_one(z);
+    num_bessel_j(x, nu, z);
+    j = num_real_d(x);
+    num_bessel_y(x, nu, z);
+    y = num_real_d(x);
+    num_bessel_i(x, nu, z);
+    i = num_real_d(x);
+    num_bessel_k(x, nu, z);
+    k = num_real_d(x);
+    delete(nu), delete(z), delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(0.7651976865579666, j);
+    TEST_ASSERT_EQUAL_DOUBLE(0.08825696421567696, y);
+    TEST_ASSERT_EQUAL_DOUBLE(1.2660658777520082, i);
+    TEST_ASSERT_EQUAL_DOUBLE(0.42102443824070834, k);
+}
+
+void
+test_num_bessel_j_vec (void)
+{
+    num_t nu, z[2], x[2];
+    double res[2];
+
+    nu = new(num);
+    z[0] = new(num), z[1] = new(num);
+    x[0] = new(num), x[1] = new(num);
+    num_zero(nu);
+    num_zero(z[0]);
+    num_one(z[1]);
+    num_bessel_j_vec(x, nu, z, 2);
+    res[0] = num_real_d(x[0]), res[1] = num_real_d(x[1]);
+    delete(nu);
+    delete(z[0]), delete(z[1]);
+    delete(x[0]), delete(x[1]);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, res[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.7651976865579666, res[1]);
+}
+
+void
+test_num_expint (void)
+{
+    num_t s, z;
+    double res;
+
+    s = new(num), z = new(num);
+    num_one(s);
+    num_one(z);
+    num_expint(z, s, z);
+    res = num_real_d(z);
+    delete(s), delete(z);
+
+    TEST_ASSERT_EQUAL_DOUBLE(0.21938393439552029, res);
+}
+
+/* Gamma(1, z) = exp(-z) */
+void
+test_num_incgamma (void)
+{
+    num_t s, z;
+    double res;
+
+    s = new(num), z = new(num);
+    num_one(s);
+    num_set_d(z, 2.0);
+    num_incgamma(z, s, z);
+    res = num_real_d(z);
+    delete(s), delete(z);
+
+    TEST_ASSERT_EQUAL_DOUBLE(0.1353352832366127, res);
+}
+
+/* 1F1(1; 2; z) = (exp(z) - 1)/z */
+void
+test_num_hyp1f1 (void)
+{
+    num_t a, b, z;
+    double res;
+
+    a = new(num), b = new(num), z = new(num);
+    num_one(a);
+    num_set_d(b, 2.0);
+    num_one(z);
+    num_hyp1f1(z, a, b, z);
+    res = num_real_d(z);
+    delete(a), delete(b), delete(z);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.718281828459045, res);
+}
+
+/* 2F1(1, 1; 2; z) = -log(1 - z)/z */
+void
+test_num_hyp2f1 (void)
+{
+    num_t a, c, z;
+    double res;
+
+    a = new(num), c = new(num), z = new(num);
+    num_one(a);
+    num_set_d(c, 2.0);
+    num_set_d(z, 0.5);
+    num_hyp2f1(z, a, a, c, z);
+    res = num_real_d(z);
+    delete(a), delete(c), delete(z);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.3862943611198906, res);
+}
+
+void
+test_numtab_erf (void)
+{
+    numtab_t t;
+    num_t x;
+    double res, ref, err;
+
+    t = new(numtab, num_erf, -4.0, 4.0, 32, 12);
+    x = new(num);
+    num_set_d(x, 0.3);
+    num_erf(x, x);
+    ref = num_to_d(x);
+    res = numtab_eval_d(t, 0.3);
+    err = numtab_error_estimate(t);
+    delete(x), delete(t);
+    
+    TEST_ASSERT_MESSAGE(err < 1e-12, "erf table is not accurate");
+    TEST_ASSERT_DOUBLE_WITHIN(err, ref, res);
+}
+
+void
+test_numtab_vec (void)
+{
+    numtab_t t;
+    double x[3] = {0.5, 1.5, 10.0};
+    double res[3];
+
+    t = new(numtab, num_exp, 0.0, 2.0, 16, 10);
+    numtab_eval_vec(t, res, x, 3);
+    delete(t);
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 1.64872127070013, res[0]);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 4.48168907033806, res[1]);
+    /* Outside of the table */
+    TEST_ASSERT_EQUAL_DOUBLE(22026.4657948067, res[2]);
+}
+
+/* x^2 - c, with c = 2 unless given in ctx */
+static void
+square_minus (num_t res, const num_t x, void * ctx)
+{
+    const double c = ctx ? * (double *) ctx : 2.0;
+    num_mul(res, x, x);
+    num_add_d(res, res, -c);
+}
+
+static void
+square_plus_one (num_t res, const num_t x, void * ctx)
+{
+    UNUSED(ctx);
+    num_mul(res, x, x);
+    num_add_d(res, res, 1.0);
+}
+
+static void
+twice (num_t res, const num_t x, void * ctx)
+{
+    UNUSED(ctx);
+    num_mul_d(res, x, 2.0);
+}
+
+/* cos(x) - x and its derivatives */
+static void
+cos_minus_x (num_t res, const num_t x, void * ctx)
+{
+    UNUSED(ctx);
+    num_cos(res, x);
+    num_sub(res, res, x);
+}
+
+static void
+cos_minus_x_d (num_t res, const num_t x, void * ctx)
+{
+    UNUSED(ctx);
+    num_sin(res, x);
+    num_neg(res, res);
+    num_add_d(res, res, -1.0);
+}
+
+static void
+cos_minus_x_d2 (num_t res, const num_t x, void * ctx)
+{
+    UNUSED(ctx);
+    num_cos(res, x);
+    num_neg(res, res);
+}
+
+/* (x - 1)^2 */
+static void
+parabola (num_t res, const num_t x, void * ctx)
+{
+    UNUSED(ctx);
+    num_add_d(res, x, -1.0);
+    num_mul(res, res, res);
+}
+
+void
+test_num_solve_bisect (void)
+{
+    num_t a, b, x;
+    int status;
+    double res;
+
+    a = new(num), b = new(num), x = new(num);
+    num_set_d(a, 1.0);
+    num_set_d(b, 2.0);
+    status = num_solve_bisect(x, square_minus, NULL, a, b, 1e-12, 100);
+    res = num_real_d(x);
+    delete(a), delete(b), delete(x);
+
+    TEST_ASSERT_EQUAL_INT(NUM_SOLVE_OK, status);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 1.4142135623730951, res);
+}
+
+void
+test_num_solve_brent (void)
+{
+    num_t a, b, x;
+    int status;
+    double res;
+
+    a = new(num), b = new(num), x = new(num);
+    num_set_d(a, 1.0);
+    num_set_d(b, 2.0);
+    status = num_solve_brent(x, square_minus, NULL, a, b, 1e-14, 100);
+    res = num_to_d(x);
+    delete(a), delete(b), delete(x);
+
+    TEST_ASSERT_EQUAL_INT(NUM_SOLVE_OK, status);
+    TEST_ASSERT_EQUAL_DOUBLE(1.4142135623730951, res);
+}
+
+void
+test_num_solve_newton (void)
+{
+    num_t x;
+    int status;
+    double complex res;
+
+    x = new(num);
+    num_set_d_d(x, 1.0, 1.0);
+    status = num_solve_newton(x, square_plus_one, twice, NULL, x, 1e-14, 50);
+    res = num_to_complex(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_INT(NUM_SOLVE_OK, status);
+    TEST_ASSERT_DOUBLE_WITHIN(DELTA, 0.0, creal(res));
+    TEST_ASSERT_DOUBLE_WITHIN(DELTA, 1.0, cimag(res));
+}
+
+void
+test_num_solve_halley (void)
+{
+    num_t x;
+    int status;
+    double res;
+
+    x = new(num);
+    num_one(x);
+    status = num_solve_halley(x, cos_minus_x, cos_minus_x_d, cos_minus_x_d2, NULL, x, 1e-14, 50);
+    res = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_INT(NUM_SOLVE_OK, status);
+    TEST_ASSERT_EQUAL_DOUBLE(0.7390851332151607, res);
+}
+
+void
+test_num_solve_newton_vec (void)
+{
+    /* The last problem starts where the derivative 2x vanishes */
+    double c[4] = {2.0, 3.0, 4.0, 5.0};
+    void * ctx[4] = {&c[0], &c[1], &c[2], &c[3]};
+    num_t x0[4], x[4];
+    int status[4];
+    double res[4];
+    size_t done;
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        x0[i] = new(num), x[i] = new(num);
+        num_one(x0[i]);
+    }
+    num_zero(x0[3]);
+    done = num_solve_newton_vec(x, status, square_minus, twice, ctx, x0, 4, 1e-14, 50);
+    for (i = 0; i < 4; i++)
+    {
+        res[i] = num_real_d(x[i]);
+        delete(x0[i]), delete(x[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(3, done);
+    for (i = 0; i < 3; i++)
+        TEST_ASSERT_EQUAL_INT(NUM_SOLVE_OK, status[i]);
+    TEST_ASSERT_EQUAL_INT(NUM_SOLVE_ZERO_DERIVATIVE, status[3]);
+    TEST_ASSERT_EQUAL_DOUBLE(1.4142135623730951, res[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(1.7320508075688772, res[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, res[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, res[3]);
+}
+
+void
+test_num_minimize_golden (void)
+{
+    num_t a, b, x;
+    int status;
+    double res;
+
+    a = new(num), b = new(num), x = new(num);
+    num_set_d(a, -3.0);
+    num_set_d(b, 4.0);
+    status = num_minimize_golden(x, parabola, NULL, a, b, 1e-8, 200);
+    res = num_to_d(x);
+    delete(a), delete(b), delete(x);
+
+    TEST_ASSERT_EQUAL_INT(NUM_SOLVE_OK, status);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-7, 1.0, res);
+}
+
+static void
+exp_integrand (num_t res, const num_t x, void * ctx)
+{
+    UNUSED(ctx);
+    num_exp(res, x);
+}
+
+static void
+sin_integrand (num_t res, const num_t x, void * ctx)
+{
+    UNUSED(ctx);
+    num_sin(res, x);
+}
+
+void
+test_num_quad_gl (void)
+{
+    num_t a, b, x, y;
+    double complex res, res_threaded;
+
+    a = new(num), b = new(num), x = new(num), y = new(num);
+    num_zero(a);
+    num_one(b);
+    num_quad_gl(x, exp_integrand, NULL, a, b, 12, 1);
+    num_quad_gl(y, exp_integrand, NULL, a, b, 12, 4);
+    res = num_to_complex(x), res_threaded = num_to_complex(y);
+    delete(a), delete(b), delete(x), delete(y);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.718281828459045, creal(res));
+    TEST_ASSERT_MESSAGE(res == res_threaded, "result depends on the number of threads");
+}
+
+void
+test_num_quad_gk (void)
+{
+    num_t a, b, x;
+    int status;
+    double res;
+
+    a = new(num), b = new(num), x = new(num);
+    num_zero(a);
+    num_set_d(b, M_PI);
+    status = num_quad_gk(x, sin_integrand, NULL, a, b, 1e-14, 1e-14, 1000);
+    res = num_to_d(x);
+    delete(a), delete(b), delete(x);
+
+    TEST_ASSERT_EQUAL_INT(NUM_QUAD_OK, status);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, res);
+}
+
+/* sqrt(x), counting its evaluations in ctx */
+static void
+counted_sqrt_integrand (num_t res, const num_t x, void * ctx)
+{
+    int * count = ctx;
+
+    (* count)++;
+    num_sqrt(res, x);
+}
+
+void
+test_num_quad_gk_maxeval (void)
+{
+    num_t a, b, x;
+    int status, count = 0;
+
+    a = new(num), b = new(num), x = new(num);
+    num_zero(a);
+    num_one(b);
+    /* Unreachable tolerances: 15 + 2 * 30 evaluations fit in 100 */
+    status = num_quad_gk(x, counted_sqrt_integrand, &count, a, b, 0.0, 0.0, 100);
+    delete(a), delete(b), delete(x);
+
+    TEST_ASSERT_EQUAL_INT(NUM_QUAD_MAXEVAL, status);
+    TEST_ASSERT_EQUAL_INT(75, count);
+}
+
+void
+test_num_quad_rigorous (void)
+{
+    num_t a, b, x;
+    int status;
+    double res;
+
+    a = new(num), b = new(num), x = new(num);
+    num_zero(a);
+    num_one(b);
+    status = num_quad_rigorous(x, exp_integrand, NULL, a, b, 1e-15);
+    res = num_real_d(x);
+    delete(a), delete(b), delete(x);
+
+    TEST_ASSERT_EQUAL_INT(NUM_QUAD_OK, status);
+    TEST_ASSERT_EQUAL_DOUBLE(1.718281828459045, res);
+}
+
+void
+test_numser_arith (void)
+{
+    num_t x, d[3];
+    numser_t f, g;
+    double h, dh, d2h;
+    bool negative;
+    int k;
+
+    x = new(num), f = new(numser, 3), g = new(numser, 3);
+    for (k = 0; k < 3; k++) d[k] = new(num);
+    num_set_d(x, 0.5);
+    numser_set_var(f, x);
+    num_one(x);
+    numser_add_num(g, f, x);
+    numser_div(g, f, g);
+    numser_mul(g, g, f);
+    for (k = 0; k < 3; k++) numser_deriv(d[k], g, k);
+    h = num_real_d(d[0]), dh = num_real_d(d[1]), d2h = num_real_d(d[2]);
+    numser_coeff(x, g, -1);
+    negative = num_is_zero(x);
+    numser_deriv(x, g, -1);
+    negative = negative && num_is_zero(x);
+    for (k = 0; k < 3; k++) delete(d[k]);
+    delete(x), delete(f), delete(g);
+
+    /* h = x^2 / (x + 1), h' = (x^2 + 2x) / (x + 1)^2, h'' = 2 / (x + 1)^3 */
+    TEST_ASSERT_DOUBLE_WITHIN(DELTA, 1.0 / 6.0, h);
+    TEST_ASSERT_DOUBLE_WITHIN(DELTA, 5.0 / 9.0, dh);
+    TEST_ASSERT_DOUBLE_WITHIN(DELTA, 16.0 / 27.0, d2h);
+    /* No coefficient of negative order */
+    TEST_ASSERT_TRUE(negative);
+}
+
+void
+test_numser_exp_log (void)
+{
+    num_t x;
+    numser_t f, g;
+    double dh;
+
+    x = new(num), f = new(numser, 2), g = new(numser, 2);
+    num_set_d(x, 2.0);
+    numser_set_var(f, x);
+    numser_exp(g, f);
+    numser_log(f, f);
+    numser_mul(g, g, f);
+    numser_deriv(x, g, 1);
+    dh = num_real_d(x);
+    delete(x), delete(f), delete(g);
+
+    /* (e^x log x)' = e^x (log x + 1/x) */
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, exp(2.0) * (log(2.0) + 0.5), dh);
+}
+
+void
+test_numser_pow (void)
+{
+    num_t x;
+    numser_t f;
+    double dh;
+
+    x = new(num), f = new(numser, 2);
+    num_set_d(x, 2.0);
+    numser_set_var(f, x);
+    numser_pow(f, f, f);
+    numser_deriv(x, f, 1);
+    dh = num_real_d(x);
+    delete(x), delete(f);
+
+    /* (x^x)' = x^x (1 + log x) */
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 4.0 * (1.0 + log(2.0)), dh);
+}
+
+void
+test_numser_erf_rgamma (void)
+{
+    num_t x;
+    numser_t f, g;
+    double derf, drgamma;
+
+    x = new(num), f = new(numser, 2), g = new(numser, 2);
+    num_set_d(x, 0.3);
+    numser_set_var(f, x);
+    numser_erf(g, f);
+    numser_deriv(x, g, 1);
+    derf = num_real_d(x);
+    num_one(x);
+    numser_set_var(f, x);
+    numser_rgamma(g, f);
+    numser_deriv(x, g, 1);
+    drgamma = num_real_d(x);
+    delete(x), delete(f), delete(g);
+
+    /* erf'(x) = 2 exp(-x^2) / sqrt(pi), (1/Gamma)'(1) = Euler's constant */
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 2.0 * exp(-0.09) / sqrt(M_PI), derf);
+    TEST_ASSERT_DOUBLE_WITHIN(DELTA, 0.5772156649015329, drgamma);
+}
+
+void
+test_numvec_sort (void)
+{
+    const size_t n = 20000;
+    num_t * v, * x;
+    bool sorted = true, stable = true;
+    size_t i;
+
+    v = num_new_array(n);
+    x = malloc(n * sizeof(num_t));
+    for (i = 0; i < n; i++)
+    {
+        num_set_d(v[i], (double) ((i * 7919) % 1000) - 500.0);
+        x[i] = v[i];
+    }
+    numvec_sort(x, n, 4);
+    for (i = 1; i < n; i++)
+    {
+        sorted = sorted && num_real_d(x[i - 1]) <= num_real_d(x[i]);
+        /* Equal values keep their order, which is that of their addresses */
+        if (num_real_d(x[i - 1]) == num_real_d(x[i]))
+            stable = stable && x[i - 1] < x[i];
+    }
+    free(x);
+    num_delete_array(v, n);
+
+    TEST_ASSERT_TRUE(sorted);
+    TEST_ASSERT_TRUE(stable);
+}
+
+void
+test_numvec_argsort (void)
+{
+    const double d[5] = {3.0, -1.0, 2.5, -1.0, 0.0};
+    const size_t expected[5] = {1, 3, 4, 2, 0};
+    num_t * v;
+    size_t perm[5];
+    size_t i;
+
+    v = num_new_array(5);
+    for (i = 0; i < 5; i++) num_set_d(v[i], d[i]);
+    numvec_argsort(perm, v, 5, 1);
+    num_delete_array(v, 5);
+
+    for (i = 0; i < 5; i++)
+        TEST_ASSERT_EQUAL(expected[i], perm[i]);
+}
+
+void
+test_numvec_nth_element (void)
+{
+    const size_t n = 101;
+    num_t * v, * x;
+    double median;
+    bool partitioned = true;
+    size_t i;
+
+    v = num_new_array(n);
+    x = malloc(n * sizeof(num_t));
+    for (i = 0; i < n; i++)
+    {
+        num_set_si(v[i], (long) ((i * 37) % n));
+        x[i] = v[i];
+    }
+    numvec_nth_element(x, 50, n);
+    median = num_to_d(x[50]);
+    for (i = 0; i < n; i++)
+        partitioned = partitioned && ((i < 50) ? num_to_d(x[i]) <= median
+                                               : num_to_d(x[i]) >= median);
+    free(x);
+    num_delete_array(v, n);
+
+    TEST_ASSERT_EQUAL_DOUBLE(50.0, median);
+    TEST_ASSERT_TRUE(partitioned);
+}
+
+void
+test_numvec_searchsorted (void)
+{
+    num_t * v, x;
+    size_t below, between, above;
+    size_t i;
+
+    v = num_new_array(4), x = new(num);
+    for (i = 0; i < 4; i++) num_set_si(v[i], 2 * (long) i);
+    num_set_d(x, -1.0);
+    below = numvec_searchsorted(v, 4, x);
+    num_set_d(x, 2.0);
+    between = numvec_searchsorted(v, 4, x);
+    num_set_d(x, 10.0);
+    above = numvec_searchsorted(v, 4, x);
+    num_delete_array(v, 4), delete(x);
+
+    TEST_ASSERT_EQUAL(0, below);
+    TEST_ASSERT_EQUAL(1, between);
+    TEST_ASSERT_EQUAL(4, above);
+}
+
+void
+test_numvec_is_real_mask (void)
+{
+    const size_t n = 70;
+    num_t * v = num_new_array(n);
+    uint64_t real[2], zero[2];
+    size_t i;
+
+    /* Every third value complex, and value 65 zero, across two words */
+    for (i = 0; i < n; i++)
+        num_set_d_d(v[i], (i == 65) ? 0.0 : 1.0 + i, (i % 3 == 0) ? 0.5 : 0.0);
+    numvec_is_real_mask(real, v, n);
+    numvec_is_zero_mask(zero, v, n);
+    num_delete_array(v, n);
+
+    TEST_ASSERT_TRUE(real[0] == UINT64_C(0x6db6db6db6db6db6));
+    TEST_ASSERT_TRUE(real[1] == UINT64_C(0x1b));
+    TEST_ASSERT_TRUE(zero[0] == 0 && zero[1] == UINT64_C(0x2));
+}
+
+void
+test_numvec_lt_mask (void)
+{
+    const size_t n = 8;
+    num_t * x = num_new_array(n), * y = num_new_array(n);
+    uint64_t lt[1], lt_d[1];
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        num_set_si(x[i], (long) i);
+        num_set_d(y[i], 3.5);
+    }
+    numvec_lt_mask(lt, x, (const num_t *) y, n);
+    numvec_lt_d_mask(lt_d, x, n, 5.0);
+    num_delete_array(x, n), num_delete_array(y, n);
+
+    TEST_ASSERT_TRUE(lt[0] == UINT64_C(0xf));
+    TEST_ASSERT_TRUE(lt_d[0] == UINT64_C(0x1f));
+}
+
+void
+test_numvec_compress (void)
+{
+    const size_t n = 100;
+    num_t * v = num_new_array(n), * kept = malloc(n * sizeof(num_t));
+    uint64_t mask[2];
+    size_t i, k, count;
+    bool ordered = true;
+
+    for (i = 0; i < n; i++)
+        num_set_d(v[i], (double) i - 49.5);
+    numvec_lt_d_mask(mask, v, n, 0.0);
+    count = numvec_mask_count(mask, n);
+    k = numvec_compress(kept, v, mask, n);
+    for (i = 0; i < k; i++)
+        ordered = ordered && (kept[i] == v[i]);
+    num_delete_array(v, n);
+    free(kept);
+
+    TEST_ASSERT_EQUAL(50, count);
+    TEST_ASSERT_EQUAL(50, k);
+    TEST_ASSERT_TRUE(ordered);
+}
+
+static size_t
+pipe_source (num_t* chunk, const size_t max, void * ctx)
+{
+    long * next = ctx;
+    size_t i;
+
+    for (i = 0; i < max && * next < 1000; i++)
+        num_set_si(chunk[i], (* next)++);
+    return i;
+}
+
+static void
+pipe_square (num_t* chunk, const size_t n, void * ctx)
+{
+    UNUSED(ctx);
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        num_mul(chunk[i], chunk[i], chunk[i]);
+}
+
+static void
+pipe_sink (const num_t* chunk, const size_t n, void * ctx)
+{
+    double * sum = ctx;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        * sum += num_to_d(chunk[i]);
+}
+
+void
+test_numpipe (void)
+{
+    numpipe_t p;
+    struct numpipe_stats stats;
+    long next = 0;
+    double sum = 0.0;
+    size_t n;
+
+    p = new(numpipe, (size_t) 64, (size_t) 3);
+    numpipe_add_stage(p, pipe_square, NULL);
+    n = numpipe_run(p, pipe_source, &next, pipe_sink, &sum);
+    numpipe_stats(p, 1, &stats);
+    delete(p);
+
+    /* Sum of the squares of 0, ..., 999 */
+    TEST_ASSERT_EQUAL(1000, n);
+    TEST_ASSERT_EQUAL_DOUBLE(332833500.0, sum);
+    TEST_ASSERT_EQUAL(1000, stats.values);
+    TEST_ASSERT_EQUAL(16, stats.chunks);
+}
+
+void
+test_num_new_array (void)
+{
+    num_t * v;
+    bool zero, overflow;
+    double res;
+
+    v = num_new_array(3);
+    zero = num_is_zero(v[0]) && num_is_zero(v[1]) && num_is_zero(v[2]);
+    num_set_d(v[0], 1.5);
+    num_set_d_d(v[1], 2.0, 1.0);
+    num_mul(v[2], v[0], v[1]);
+    res = num_real_d(v[2]);
+    num_delete_array(v, 3);
+    /* The size of the block overflows */
+    overflow = num_new_array(SIZE_MAX / 8) == NULL;
+
+    TEST_ASSERT_MESSAGE(zero, "new values are not zero");
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, res);
+    TEST_ASSERT_TRUE(overflow);
+}
+
+void
+test_num_is_identical (void)
+{
+    num_t x, y;
+    bool same, other;
+
+    x = new(num), y = new(num);
+    num_set_d(x, 0.1);
+    num_set_d(y, 0.1);
+    same = num_is_identical(x, y);
+    num_mul_d(y, y, 3.0);
+    num_div_d(y, y, 3.0);
+    other = num_is_identical(x, y);
+    delete(x), delete(y);
+
+    /* The roundings widen the radius of y */
+    TEST_ASSERT_TRUE(same);
+    TEST_ASSERT_FALSE(other);
+}
+
+void
+test_num_sum_vec (void)
+{
+    const size_t n = 1000;
+    num_t * v, ref, res;
+    bool identical = true;
+    double sum;
+    size_t i;
+    int t;
+
+    v = num_new_array(n), ref = new(num), res = new(num);
+    for (i = 0; i < n; i++)
+        num_set_d_d(v[i], 1.0 / (i + 1), (double) (i % 7) - 3.0);
+    num_sum_vec(ref, v, n, 1);
+    for (t = 2; t <= 8; t++)
+    {
+        num_sum_vec(res, v, n, t);
+        identical = identical && num_is_identical(res, ref);
+    }
+    sum = num_real_d(ref);
+    num_delete_array(v, n), delete(ref), delete(res);
+
+    /* Harmonic number H_1000 */
+    TEST_ASSERT_TRUE(identical);
+    TEST_ASSERT_DOUBLE_WITHIN(DELTA, 7.485470860550345, sum);
+}
+
+void
+test_num_dot_vec (void)
+{
+    const size_t n = 1000;
+    num_t * x, * y, ref, res;
+    bool identical = true;
+    double dot;
+    size_t i;
+    int t;
+
+    x = num_new_array(n), y = num_new_array(n), ref = new(num), res = new(num);
+    for (i = 0; i < n; i++)
+    {
+        num_set_d_d(x[i], 1.0 / (i + 1), 0.5);
+        num_set_si(y[i], (long) i + 1);
+    }
+    num_dot_vec(ref, x, y, n, 1);
+    for (t = 2; t <= 8; t++)
+    {
+        num_dot_vec(res, x, y, n, t);
+        identical = identical && num_is_identical(res, ref);
+    }
+    dot = num_real_d(ref);
+    num_delete_array(x, n), num_delete_array(y, n), delete(ref), delete(res);
+
+    TEST_ASSERT_TRUE(identical);
+    TEST_ASSERT_DOUBLE_WITHIN(DELTA, 1000.0, dot);
+}
+
+void
+test_num_memory_usage (void)
+{
+    num_t x;
+    fmpz_t big;
+    size_t small, large, shell;
+
+    x = new(num);
+    fmpz_init(big);
+    num_set_d(x, 0.1);
+    small = num_memory_usage(x);
+    shell = size_of(x);
+    fmpz_set_ui(big, 10);
+    fmpz_pow_ui(big, big, 40);
+    num_set_fmpz(x, big);
+    large = num_memory_usage(x);
+    fmpz_clear(big);
+    delete(x);
+
+    /* 10^40 needs more than the limbs kept inline by Arb */
+    TEST_ASSERT_EQUAL(shell, small);
+    TEST_ASSERT_GREATER_THAN(shell, large);
+}
+
+void
+test_num_thread_memory_peak (void)
+{
+    num_t x;
+    long allocations, peak, live;
+
+    num_thread_memory_reset();
+    x = new(num);
+    num_set_d(x, 30.5);
+    num_digamma(x, x);
+    delete(x);
+    allocations = num_thread_allocations();
+    peak = num_thread_memory_peak();
+    live = num_thread_memory();
+
+    TEST_ASSERT_GREATER_THAN(0, allocations);
+    TEST_ASSERT_MESSAGE(peak >= live, "the peak is below the live memory");
+}
+
+void
+test_num_thread_cleanup (void)
+{
+    num_t x;
+    long before, after;
+
+    x = new(num);
+    num_set_d(x, 30.5);
+    num_digamma(x, x);
+    delete(x);
+    before = num_thread_memory();
+    num_thread_cleanup();
+    after = num_thread_memory();
+
+    TEST_ASSERT_MESSAGE(after <= before, "cleanup did not release memory");
+}
+
+void
+test_num_set_str (void)
+{
+    num_t x;
+    bool ok[5];
+    double re[5], im[5], rad[5];
+    int k;
+    const char * text[5] = {"0.1", " 1.5-2e-1i ", "-i", "[3.25 +/- 0.01]", "1.2.3"};
+
+    x = new(num);
+    for (k = 0; k < 5; k++)
+    {
+        num_zero(x);
+        ok[k] = num_set_str(x, text[k]);
+        re[k] = num_real_d(x), im[k] = num_imag_d(x), rad[k] = num_rad_d(x);
+    }
+    delete(x);
+
+    TEST_ASSERT_TRUE(ok[0] && ok[1] && ok[2] && ok[3]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.1, re[0]);
+    TEST_ASSERT_TRUE(rad[0] > 0.0 && rad[0] < 1e-16);
+    TEST_ASSERT_EQUAL_DOUBLE(1.5, re[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(-0.2, im[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, re[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(-1.0, im[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(3.25, re[3]);
+    TEST_ASSERT_TRUE(rad[3] >= 0.01);
+    /* A bad string leaves the value alone */
+    TEST_ASSERT_FALSE(ok[4]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, re[4]);
+}
+
+void
+test_num_set_str_vec (void)
+{
+    const char * text = "1, 2.5e1,-3\n\n4i,,5\n6,x,7";
+    num_t * v = num_new_array(8);
+    size_t n;
+    double got[5];
+    int k;
+
+    n = num_set_str_vec(v, 8, text, strlen(text));
+    for (k = 0; k < 5; k++)
+        got[k] = num_real_d(v[k]);
+    got[3] = num_imag_d(v[3]);
+    num_delete_array(v, 8);
+
+    /* The empty fields are skipped and "x" stops the parse */
+    TEST_ASSERT_EQUAL(6, n);
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, got[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(25.0, got[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(-3.0, got[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(4.0, got[3]);
+    TEST_ASSERT_EQUAL_DOUBLE(5.0, got[4]);
+}
+
+void
+test_num_const (void)
+{
+    num_t x;
+    double c[5], rad;
+
+    num_const_warmup(128);
+    x = new(num);
+    num_const_pi(x), c[0] = num_real_d(x);
+    rad = num_rad_d(x);
+    num_const_e(x), c[1] = num_real_d(x);
+    num_const_log2(x), c[2] = num_real_d(x);
+    num_const_euler(x), c[3] = num_real_d(x);
+    num_const_catalan(x), c[4] = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(3.14159265358979323846, c[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(2.71828182845904523536, c[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.69314718055994530942, c[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.57721566490153286061, c[3]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.91596559417721901505, c[4]);
+    /* Rounded from the 128-bit value to the working precision */
+    TEST_ASSERT_TRUE(rad < 1e-15);
+}
+
+void
+test_num_warmup (void)
+{
+    num_t x;
+    bool all, some, unknown;
+    double y;
+
+    all = num_warmup(NULL, 53);
+    some = num_warmup("exp,,erf", 128);
+    unknown = num_warmup("erf,nosuch", 53);
+    x = new(num);
+    num_set_d(x, 0.5);
+    num_erf(x, x);
+    y = num_real_d(x);
+    delete(x);
+
+    TEST_ASSERT_TRUE(all);
+    TEST_ASSERT_TRUE(some);
+    TEST_ASSERT_FALSE(unknown);
+    TEST_ASSERT_EQUAL_DOUBLE(0.52049987781304654, y);
+}
+
+void
+test_num_profile_dump (void)
+{
+    FILE * f = tmpfile();
+    char text[64] = {0};
+    size_t len;
+
+    num_profile_reset();
+    num_profile_dump(f);
+    rewind(f);
+    len = fread(text, 1, sizeof(text) - 1, f);
+    fclose(f);
+
+    TEST_ASSERT_GREATER_THAN(0, len);
+    TEST_ASSERT_EQUAL_STRING("{\"functions\": [\n]}\n", text);
+}
+
+#ifdef NUM_PROFILE
+void
+test_num_profile_record (void)
+{
+    FILE * f = tmpfile();
+    char text[4096] = {0};
+    const char * entry;
+    const char * p;
+    unsigned long lower, count, total = 0;
+    size_t len;
+    bool exp_seen, add_seen;
+    int i;
+    num_t x, y;
+
+    x = new(num), y = new(num);
+    num_set_d(x, 1.0);
+
+    num_profile_reset();
+    for (i = 0; i < 3; i++)
+        num_exp(y, x);
+    num_set_d(x, 0.0);
+    num_add(y, x, x);
+    num_profile_dump(f);
+    rewind(f);
+    len = fread(text, 1, sizeof(text) - 1, f);
+    fclose(f);
+    delete(x), delete(y);
+
+    entry = strstr(text, "{\"function\": \"num_exp\", \"class\": \"unit\", "
+                   "\"calls\": 3,");
+    exp_seen = (entry != NULL);
+    add_seen = (strstr(text, "{\"function\": \"num_add\", \"class\": \"zero\", "
+                        "\"calls\": 1,") != NULL);
+
+    /* The buckets of num_exp hold its 3 calls */
+    p = exp_seen ? strstr(entry, "\"buckets\": [") : NULL;
+    if (p != NULL)
+    {
+        p += strlen("\"buckets\": [");
+        while (sscanf(p, "[%lu, %lu]", &lower, &count) == 2)
+        {
+            total += count;
+            p = strchr(p, ']') + 1;
+            if (strncmp(p, ", ", 2) != 0) break;
+            p += 2;
+        }
+    }
+
+    num_profile_reset();
+
+    TEST_ASSERT_GREATER_THAN(0, len);
+    TEST_ASSERT_TRUE(exp_seen);
+    TEST_ASSERT_TRUE(add_seen);
+    TEST_ASSERT_EQUAL_INT(3, total);
+}
+#endif
+
+void
+test_numr_arith (void)
+{
+    numr_t x, y;
+    double r[4];
+    bool lt, eq;
+
+    x = new(numr), y = new(numr);
+    numr_set_d(x, 1.5), numr_set_si(y, -4);
+    numr_add(x, x, y), r[0] = numr_to_d(x);
+    numr_mul_d(x, x, 2.0), r[1] = numr_to_d(x);
+    numr_div(x, x, y), r[2] = numr_to_d(x);
+    numr_pow_si(y, y, 3), r[3] = numr_to_d(y);
+    lt = numr_lt(y, x);
+    eq = numr_eq(x, x);
+    delete(x), delete(y);
+
+    TEST_ASSERT_EQUAL_DOUBLE(-2.5, r[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(-5.0, r[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(1.25, r[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(-64.0, r[3]);
+    TEST_ASSERT_TRUE(lt);
+    TEST_ASSERT_TRUE(eq);
+}
+
+void
+test_numr_functions (void)
+{
+    numr_t x;
+    double r[4];
+    bool indeterminate;
+
+    x = new(numr);
+    numr_set_d(x, 0.5);
+    numr_erf(x, x), r[0] = numr_to_d(x);
+    numr_set_d(x, 2.0);
+    numr_log(x, x), r[1] = numr_to_d(x);
+    numr_set_d(x, 5.0);
+    numr_gamma(x, x), r[2] = numr_to_d(x);
+    numr_set_d(x, -8.0);
+    numr_cbrt(x, x), r[3] = numr_to_d(x);
+    numr_set_d(x, -1.0);
+    numr_sqrt(x, x);
+    indeterminate = !(numr_rad_d(x) < 1.0);
+    delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(0.52049987781304654, r[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.69314718055994530942, r[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(24.0, r[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(-2.0, r[3]);
+    /* Outside of the real domain */
+    TEST_ASSERT_TRUE(indeterminate);
+}
+
+void
+test_numr_real_api (void)
+{
+    numr_t x, y, z;
+    double r[6];
+    bool parsed, rejected, cmp, ceil_mid;
+
+    x = new(numr), y = new(numr), z = new(numr);
+    numr_set_d(x, 1.0), numr_set_d(y, -1.0);
+    numr_atan2(z, x, y), r[0] = numr_to_d(z);
+    numr_set_d(x, 7.5), numr_set_d(y, 2.0);
+    numr_fmod(z, x, y), r[1] = numr_to_d(z);
+    numr_max(z, x, y), r[2] = numr_to_d(z);
+    numr_add_si(z, y, 3), numr_div_ui(z, z, 2), r[3] = numr_to_d(z);
+    numr_zero(x), numr_one(y);
+    numr_bessel_j(z, x, y), r[4] = numr_to_d(z);
+    numr_set_str(x, "[1.5 +/- 0.6]");
+    numr_ceil(x, x);
+    ceil_mid = numr_eq_d(x, 2.0) && numr_rad_d(x) == 0.0;
+    parsed = numr_set_str(x, " 3.25 +/- 0.5 ") && numr_to_d(x) == 3.25 && numr_rad_d(x) >= 0.5;
+    parsed = parsed && numr_set_str(x, "0.25");
+    rejected = !numr_set_str(y, "1+2i") && !numr_set_str(y, "") && !numr_set_str(y, "1.5x");
+    numr_sin_cos(y, z, x), r[5] = numr_to_d(z);
+    cmp = numr_eq_d(x, 0.25) && numr_gt_d(x, 0.0) && numr_le_d(x, 0.25) && !numr_ge_d(x, 1.0);
+    delete(x), delete(y), delete(z);
+
+    TEST_ASSERT_EQUAL_DOUBLE(2.3561944901923448, r[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(1.5, r[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(7.5, r[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(2.5, r[3]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.76519768655796655, r[4]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.96891242171064473, r[5]);
+    TEST_ASSERT_TRUE(parsed);
+    TEST_ASSERT_TRUE(rejected);
+    TEST_ASSERT_TRUE(cmp);
+    /* The ceiling of the midpoint, not a ball over [1, 3] */
+    TEST_ASSERT_TRUE(ceil_mid);
+}
+
+void
+test_numr_interop (void)
+{
+    num_t z;
+    numr_t x;
+    double complex r[2];
+    double back;
+
+    z = new(num), x = new(numr);
+    numr_set_d(x, 2.0);
+    num_set_d_d(z, 3.0, 4.0);
+    num_mul_numr(z, z, x), r[0] = num_to_complex(z);
+    num_set_numr(z, x);
+    num_add_numr(z, z, x), r[1] = num_to_complex(z);
+    numr_set_num(x, z), back = numr_to_d(x);
+    delete(z), delete(x);
+
+    TEST_ASSERT_EQUAL_DOUBLE(6.0, creal(r[0]));
+    TEST_ASSERT_EQUAL_DOUBLE(8.0, cimag(r[0]));
+    TEST_ASSERT_EQUAL_DOUBLE(4.0, creal(r[1]));
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, cimag(r[1]));
+    TEST_ASSERT_EQUAL_DOUBLE(4.0, back);
+}
+
+void
+test_numr_memory_usage (void)
+{
+    num_t * z = num_new_array(4);
+    numr_t * x = numr_new_array(4);
+    size_t complex_bytes, real_bytes;
+
+    num_set_d(z[0], 0.1);
+    numr_set_d(x[0], 0.1);
+    complex_bytes = num_memory_usage(z[0]);
+    real_bytes = numr_memory_usage(x[0]);
+    num_delete_array(z, 4);
+    numr_delete_array(x, 4);
+
+    TEST_ASSERT_GREATER_THAN(0, real_bytes);
+    TEST_ASSERT_TRUE(2 * real_bytes <= complex_bytes + sizeof(void *));
+}
+
+void
+test_num_flags (void)
+{
+    const int all = NUM_FLAG_NONREAL | NUM_FLAG_DIVBYZERO | NUM_FLAG_PRECISION | NUM_FLAG_NAN;
+    num_t x, y;
+    numr_t r;
+    int none, nonreal, divbyzero, precision, nan_flag, nan_inline, sticky, cleared;
+    int nonreal_numr, divbyzero_numr, precision_numr, nan_numr;
+    double real_part;
+    bool lt;
+
+    num_clear_flags(all);
+    x = new(num), y = new(num);
+    num_set_si(x, 1), num_set_si(y, 2);
+    lt = num_lt(x, y);
+    num_set_d(x, 0.1), num_to_d(x);
+    none = num_test_flags(all);
+
+    num_set_d_d(x, 1.0, 1.0);
+    num_lt(x, y);
+    nonreal = num_test_flags(all);
+    num_clear_flags(all);
+
+    r = new(numr);
+    numr_set_num(r, x);
+    nonreal_numr = num_test_flags(all);
+    real_part = numr_to_d(r);
+    num_clear_flags(all);
+    numr_zero(r);
+    numr_inv(r, r);
+    divbyzero_numr = num_test_flags(all);
+    num_clear_flags(all);
+    numr_set_str(r, "[1 +/- 0.01]");
+    numr_to_d(r);
+    precision_numr = num_test_flags(all);
+    num_clear_flags(all);
+    numr_set_str(r, "nan");
+    numr_to_d(r);
+    nan_numr = num_test_flags(all);
+    delete(r);
+    num_clear_flags(all);
+
+    num_zero(y);
+    num_div(x, x, y);
+    divbyzero = num_test_flags(NUM_FLAG_DIVBYZERO);
+
+    num_set_str(x, "[1 +/- 0.01]");
+    num_to_d(x);
+    precision = num_test_flags(NUM_FLAG_PRECISION);
+
+    num_set_str(x, "nan");
+    num_to_d(x);
+    nan_flag = num_test_flags(NUM_FLAG_NAN);
+    num_clear_flags(NUM_FLAG_NAN);
+    num_real_d_inline(x);
+    nan_inline = num_test_flags(NUM_FLAG_NAN);
+
+    sticky = num_test_flags(all);
+    num_clear_flags(NUM_FLAG_NAN);
+    cleared = num_test_flags(all);
+    num_clear_flags(all);
+    delete(x), delete(y);
+
+    TEST_ASSERT_TRUE(lt);
+    TEST_ASSERT_EQUAL(0, none);
+    TEST_ASSERT_EQUAL(NUM_FLAG_NONREAL, nonreal);
+    TEST_ASSERT_EQUAL(NUM_FLAG_NONREAL, nonreal_numr);
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, real_part);
+    TEST_ASSERT_EQUAL(NUM_FLAG_DIVBYZERO, divbyzero_numr);
+    TEST_ASSERT_EQUAL(NUM_FLAG_PRECISION, precision_numr);
+    TEST_ASSERT_EQUAL(NUM_FLAG_NAN, nan_numr);
+    TEST_ASSERT_EQUAL(NUM_FLAG_DIVBYZERO, divbyzero);
+    TEST_ASSERT_EQUAL(NUM_FLAG_PRECISION, precision);
+    TEST_ASSERT_EQUAL(NUM_FLAG_NAN, nan_flag);
+    TEST_ASSERT_EQUAL(NUM_FLAG_NAN, nan_inline);
+    TEST_ASSERT_EQUAL(NUM_FLAG_DIVBYZERO | NUM_FLAG_PRECISION | NUM_FLAG_NAN, sticky);
+    TEST_ASSERT_EQUAL(NUM_FLAG_DIVBYZERO | NUM_FLAG_PRECISION, cleared);
+}
+
 int
 main (void)
 {
+    num_thread_init();
 
     UNITY_BEGIN();
 
@@ -601,6 +2508,16 @@ main (void)
     RUN_TEST(test_is_not_real);
     RUN_TEST(test_is_not_real_I);
     
+    RUN_TEST(test_num_set_si);
+    RUN_TEST(test_num_set_fmpz);
+    RUN_TEST(test_num_set_q);
+
+    RUN_TEST(test_num_mode_mid);
+    RUN_TEST(test_num_rel_accuracy_bits);
+
+    RUN_TEST(test_num_inline);
+    RUN_TEST(test_num_small_int);
+
     RUN_TEST(test_num_to_d);
 
     RUN_TEST(test_num_abs_real);
@@ -622,13 +2539,30 @@ main (void)
 
     RUN_TEST(test_num_sin);
     RUN_TEST(test_num_cos);
+    RUN_TEST(test_num_tan);
+    RUN_TEST(test_num_atan);
+    RUN_TEST(test_num_asin);
+    RUN_TEST(test_num_acos);
+    RUN_TEST(test_num_atan2);
+    RUN_TEST(test_num_log1p);
+    RUN_TEST(test_num_expm1);
+    RUN_TEST(test_num_cbrt);
+    RUN_TEST(test_num_cbrt_straddle);
+    RUN_TEST(test_num_rsqrt);
+    RUN_TEST(test_num_sin_cos);
+    RUN_TEST(test_num_sinh_cosh);
+    RUN_TEST(test_num_exp_pi_i);
+    RUN_TEST(test_num_sin_cos_pi_vec);
 
     RUN_TEST(test_num_add);
     RUN_TEST(test_num_sub);
     RUN_TEST(test_num_mul);
     RUN_TEST(test_num_div);
+    RUN_TEST(test_num_scalar_forms);
+    RUN_TEST(test_num_generic);
     RUN_TEST(test_num_fmod);
     RUN_TEST(test_num_pow);
+    RUN_TEST(test_num_pow_classes);
     RUN_TEST(test_num_pow_cmplx);
     RUN_TEST(test_num_eq);
     RUN_TEST(test_num_lt);
@@ -637,6 +2571,15 @@ main (void)
     RUN_TEST(test_num_erf);
     RUN_TEST(test_num_erfc);
     RUN_TEST(test_num_rgamma);
+    RUN_TEST(test_num_gamma);
+    RUN_TEST(test_num_lgamma);
+    RUN_TEST(test_num_digamma);
+    RUN_TEST(test_num_bessel);
+    RUN_TEST(test_num_bessel_j_vec);
+    RUN_TEST(test_num_expint);
+    RUN_TEST(test_num_incgamma);
+    RUN_TEST(test_num_hyp1f1);
+    RUN_TEST(test_num_hyp2f1);
 
     RUN_TEST(test_num_ceil);
     RUN_TEST(test_num_inv);
@@ -644,6 +2587,63 @@ main (void)
     RUN_TEST(test_num_cpy);
     RUN_TEST(test_num_max);
     RUN_TEST(test_num_pow_d);
+    RUN_TEST(test_num_pow_si);
+    RUN_TEST(test_num_mul_si);
+    RUN_TEST(test_num_mul_2exp);
+    RUN_TEST(test_num_div_ui);
+
+    RUN_TEST(test_numtab_erf);
+    RUN_TEST(test_numtab_vec);
+
+    RUN_TEST(test_numser_arith);
+    RUN_TEST(test_numser_exp_log);
+    RUN_TEST(test_numser_pow);
+    RUN_TEST(test_numser_erf_rgamma);
+
+    RUN_TEST(test_numvec_sort);
+    RUN_TEST(test_numvec_argsort);
+    RUN_TEST(test_numvec_nth_element);
+    RUN_TEST(test_numvec_searchsorted);
+    RUN_TEST(test_numvec_is_real_mask);
+    RUN_TEST(test_numvec_lt_mask);
+    RUN_TEST(test_numvec_compress);
+
+    RUN_TEST(test_numpipe);
+
+    RUN_TEST(test_num_new_array);
+    RUN_TEST(test_num_is_identical);
+    RUN_TEST(test_num_sum_vec);
+    RUN_TEST(test_num_dot_vec);
+    RUN_TEST(test_num_memory_usage);
+    RUN_TEST(test_num_thread_memory_peak);
+    RUN_TEST(test_num_thread_cleanup);
+    RUN_TEST(test_num_set_str);
+    RUN_TEST(test_num_set_str_vec);
+    RUN_TEST(test_num_const);
+    RUN_TEST(test_num_warmup);
+    RUN_TEST(test_num_profile_dump);
+#ifdef NUM_PROFILE
+    RUN_TEST(test_num_profile_record);
+#endif
+    RUN_TEST(test_num_flags);
+
+    RUN_TEST(test_numr_arith);
+    RUN_TEST(test_numr_functions);
+    RUN_TEST(test_numr_real_api);
+    RUN_TEST(test_numr_interop);
+    RUN_TEST(test_numr_memory_usage);
+
+    RUN_TEST(test_num_solve_bisect);
+    RUN_TEST(test_num_solve_brent);
+    RUN_TEST(test_num_solve_newton);
+    RUN_TEST(test_num_solve_halley);
+    RUN_TEST(test_num_solve_newton_vec);
+    RUN_TEST(test_num_minimize_golden);
+
+    RUN_TEST(test_num_quad_gl);
+    RUN_TEST(test_num_quad_gk);
+    RUN_TEST(test_num_quad_gk_maxeval);
+    RUN_TEST(test_num_quad_rigorous);
 
     return UNITY_END();
 }
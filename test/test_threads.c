@@ -0,0 +1,264 @@
+#include "unity.h"
+#include "num.h"
+#include "new.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define NTHREADS 8
+#define ITERATIONS 50
+
+typedef void (* unary_t) (num_t res, const num_t self);
+typedef void (* binary_t) (num_t res, const num_t self, const num_t other);
+
+static const unary_t unary[] =
+{
+    num_real, num_imag, num_abs, num_neg, num_inv, num_conj, num_arg,
+    num_sqrt, num_exp, num_log, num_sin, num_sinh, num_cos, num_cosh,
+    num_tan, num_atan, num_asin, num_acos, num_log1p, num_expm1, num_cbrt,
+    num_rsqrt, num_exp_pi_i, num_erf, num_erfc, num_rgamma, num_gamma,
+    num_lgamma, num_digamma
+};
+#define NUNARY (sizeof(unary) / sizeof(unary[0]))
+
+static const binary_t binary[] =
+{
+    num_add, num_sub, num_mul, num_div, num_pow, num_bessel_j,
+    num_bessel_y, num_bessel_i, num_bessel_k, num_expint, num_incgamma
+};
+#define NBINARY (sizeof(binary) / sizeof(binary[0]))
+
+/* Shared, read-only inputs and the single-threaded reference results */
+static num_t z, w, x, y;
+static double complex unary_ref[NUNARY];
+static double complex binary_ref[NBINARY];
+
+typedef void (* constant_t) (num_t res);
+
+static const constant_t constants[] =
+{
+    num_const_pi, num_const_e, num_const_log2, num_const_euler, num_const_catalan
+};
+#define NCONSTANTS (sizeof(constants) / sizeof(constants[0]))
+
+/* Precision of the warm-ups, above which the shared caches do not grow */
+#define WARMUP_PREC 128
+
+static const char csv[] = "0.1, -2.5e3\n[1 +/- 0.25], 1.5-2i";
+#define NCSV 4
+
+/* References of the entry points sharing caches or per-thread state */
+static double complex constant_ref[NCONSTANTS];
+static double complex str_ref, csv_ref[NCSV], sum_ref, dot_ref, mid_ref;
+static double complex sin_ref[2], cos_ref[2], sinh_ref[2], cosh_ref[2], sinpi_ref[2];
+
+void
+setUp (void)
+{
+    z = new(num), w = new(num), x = new(num), y = new(num);
+    num_set_d_d(z, 0.3, 0.2);
+    num_set_d_d(w, 1.5, -0.5);
+    num_set_d(x, 2.5);
+    num_set_d(y, -1.25);
+}
+
+void
+tearDown (void)
+{
+    delete(z), delete(w), delete(x), delete(y);
+}
+
+/*
+ * Runs the entry points with shared or per-thread state: the parser, the
+ * constant cache, the warm-ups, the reductions, the vector forms, the
+ * arithmetic mode and the exception flags. With ref set, records their
+ * results instead of comparing them.
+ */
+static bool
+hammer_shared (const bool ref)
+{
+    const int all = NUM_FLAG_NONREAL | NUM_FLAG_DIVBYZERO | NUM_FLAG_PRECISION | NUM_FLAG_NAN;
+    bool ok = true;
+    double complex c;
+    num_t r, v[NCSV], u[2], s[2], t[2];
+    size_t k;
+
+#define CHECK(value, reference) \
+    do { c = (value); if (ref) reference = c; else ok = ok && c == reference; } while (0)
+
+    r = new(num);
+    for (k = 0; k < NCSV; k++) v[k] = new(num);
+    for (k = 0; k < 2; k++) s[k] = new(num), t[k] = new(num);
+    u[0] = z, u[1] = w;
+
+    ok = ok && num_warmup("exp,gamma,lgamma", WARMUP_PREC);
+    ok = ok && !num_warmup("exp,nope", 53);
+    for (k = 0; k < NCONSTANTS; k++)
+    {
+        constants[k](r);
+        CHECK(num_to_complex(r), constant_ref[k]);
+    }
+
+    ok = ok && num_set_str(r, "-1.25e-3") && !num_set_str(r, "1.2.3");
+    CHECK(num_to_complex(r), str_ref);
+    ok = ok && num_set_str_vec(v, NCSV, csv, strlen(csv)) == NCSV;
+    for (k = 0; k < NCSV; k++)
+        CHECK(num_to_complex(v[k]), csv_ref[k]);
+
+    num_sum_vec(r, v, NCSV, 2);
+    CHECK(num_to_complex(r), sum_ref);
+    num_dot_vec(r, v, v, NCSV, 2);
+    CHECK(num_to_complex(r), dot_ref);
+
+    num_sin_cos_vec(s, t, u, 2);
+    for (k = 0; k < 2; k++)
+    {
+        CHECK(num_to_complex(s[k]), sin_ref[k]);
+        CHECK(num_to_complex(t[k]), cos_ref[k]);
+    }
+    num_sinh_cosh_vec(s, t, u, 2);
+    for (k = 0; k < 2; k++)
+    {
+        CHECK(num_to_complex(s[k]), sinh_ref[k]);
+        CHECK(num_to_complex(t[k]), cosh_ref[k]);
+    }
+    num_sin_cos_pi_vec(s, t, u, 2);
+    for (k = 0; k < 2; k++)
+        CHECK(num_to_complex(s[k]), sinpi_ref[k]);
+
+    /* The mode and the flags of this thread only */
+    num_set_mode(NUM_MODE_MID);
+    ok = ok && num_get_mode() == NUM_MODE_MID;
+    num_mul(r, z, w);
+    CHECK(num_to_complex(r), mid_ref);
+    num_set_mode(NUM_MODE_BALL);
+    num_clear_flags(all);
+    num_zero(r);
+    num_div(r, z, r);
+    ok = ok && num_test_flags(all) == NUM_FLAG_DIVBYZERO;
+    num_clear_flags(all);
+
+#undef CHECK
+    delete(r);
+    for (k = 0; k < NCSV; k++) delete(v[k]);
+    for (k = 0; k < 2; k++) delete(s[k]), delete(t[k]);
+
+    return ok;
+}
+
+/* Calls the functions which are not covered by the tables */
+static bool
+hammer_others (num_t r, num_t s)
+{
+    bool ok = true;
+    double d[2];
+    num_t v[2], u[2];
+
+    num_zero(r), num_one(r), num_onei(r);
+    num_set(r, z);
+    num_set_si(r, -3), num_set_ui(r, 3);
+    num_set_d_d(r, 1.0, 2.0);
+    num_to_d_d(d, r);
+    ok = ok && d[0] == 1.0 && d[1] == 2.0;
+    ok = ok && num_real_d(z) == 0.3 && num_imag_d(z) == 0.2;
+    ok = ok && !num_is_zero(z) && !num_is_real(z) && num_is_real(x);
+    ok = ok && num_to_d(x) == 2.5;
+
+    num_add_d(r, z, 1.0), num_mul_d(r, z, 2.0), num_mul_si(r, z, 3);
+    num_mul_2exp(r, z, 4), num_div_ui(r, z, 5);
+    num_pow_d(r, z, 3.0), num_pow_si(r, z, -2);
+    num_ceil(r, x), num_fmod(r, x, y), num_atan2(r, y, x);
+    num_max(r, x, y), num_max3(r, x, y, x);
+    ok = ok && num_eq(x, x) && num_eq_d(x, 2.5);
+    ok = ok && num_gt(x, y) && num_gt_d(x, 0.0) && num_lt(y, x);
+    ok = ok && num_ge(x, y) && num_ge_d(x, 2.5) && num_le(y, x) && num_le_d(y, 0.0);
+
+    num_sin_cos(r, s, z), num_sinh_cosh(r, s, z), num_sin_cos_pi(r, s, z);
+    num_hyp1f1(r, z, w, z), num_hyp2f1(r, z, z, w, y);
+
+    v[0] = r, v[1] = s;
+    u[0] = z, u[1] = w;
+    num_gamma_vec(v, u, 2), num_lgamma_vec(v, u, 2), num_digamma_vec(v, u, 2);
+    num_bessel_j_vec(v, w, u, 2), num_bessel_y_vec(v, w, u, 2);
+    num_bessel_i_vec(v, w, u, 2), num_bessel_k_vec(v, w, u, 2);
+    num_expint_vec(v, w, u, 2), num_incgamma_vec(v, w, u, 2);
+    num_hyp1f1_vec(v, z, w, u, 2), num_hyp2f1_vec(v, z, z, w, u, 2);
+
+    return ok;
+}
+
+static void *
+worker (void * arg)
+{
+    bool * ok = arg;
+    num_t r, s;
+    size_t i, k;
+
+    num_thread_init();
+    r = new(num), s = new(num);
+    for (i = 0; i < ITERATIONS; i++)
+    {
+        for (k = 0; k < NUNARY; k++)
+        {
+            unary[k](r, z);
+            if (num_to_complex(r) != unary_ref[k]) * ok = false;
+        }
+        for (k = 0; k < NBINARY; k++)
+        {
+            binary[k](r, w, z);
+            if (num_to_complex(r) != binary_ref[k]) * ok = false;
+        }
+        if (!hammer_others(r, s)) * ok = false;
+        if (!hammer_shared(false)) * ok = false;
+    }
+    delete(r), delete(s);
+    num_thread_cleanup();
+
+    return NULL;
+}
+
+void
+test_threads (void)
+{
+    pthread_t threads[NTHREADS];
+    bool ok[NTHREADS];
+    bool res = true;
+    num_t r;
+    size_t k;
+
+    r = new(num);
+    for (k = 0; k < NUNARY; k++)
+        unary[k](r, z), unary_ref[k] = num_to_complex(r);
+    for (k = 0; k < NBINARY; k++)
+        binary[k](r, w, z), binary_ref[k] = num_to_complex(r);
+    delete(r);
+    /* Twice, so that the references see the caches as warm as the threads */
+    hammer_shared(true);
+    hammer_shared(true);
+
+    for (k = 0; k < NTHREADS; k++)
+    {
+        ok[k] = true;
+        pthread_create(&threads[k], NULL, worker, &ok[k]);
+    }
+    for (k = 0; k < NTHREADS; k++)
+    {
+        pthread_join(threads[k], NULL);
+        res = res && ok[k];
+    }
+
+    TEST_ASSERT_MESSAGE(res, "threads disagree with the single-threaded results");
+}
+
+int
+main (void)
+{
+    num_thread_init();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_threads);
+
+    return UNITY_END();
+}